@@ -1,4 +1,5 @@
 #!/bin/bash
+set -e
 
 # Variable to store the name of the circuit
 CIRCUIT=sudoku
@@ -8,5 +9,15 @@ if [ "$1" ]; then
     CIRCUIT=$1
 fi
 
-# Compile the circuit
-circom ${CIRCUIT}.circom --r1cs --wasm --sym --c
+# Compile the circuit. circom writes into build, so that the witness
+# generator runtime in sudoku_cpp is not overwritten
+mkdir -p build
+circom ${CIRCUIT}.circom --r1cs --wasm --sym --c -o build
+mv build/${CIRCUIT}.r1cs build/${CIRCUIT}.sym .
+rm -rf ${CIRCUIT}_js
+mv build/${CIRCUIT}_js .
+
+# Only the circuit code is taken from the C++ output, rewritten for the
+# runtime of sudoku_cpp. Build it with "make CIRCUIT=${CIRCUIT}" in sudoku_cpp
+node transform_cpp.js build/${CIRCUIT}_cpp/${CIRCUIT}.cpp build/${CIRCUIT}_cpp/${CIRCUIT}.dat sudoku_cpp/${CIRCUIT}.cpp
+cp build/${CIRCUIT}_cpp/${CIRCUIT}.dat sudoku_cpp/
@@ -13,7 +13,7 @@ fi
 
 # In case there is a ptau file number as an input
 if [ "$2" ]; then
-    CIRCUIT=$2
+    PTAU=$2
 fi
 
 # Check if the necessary ptau file already exists. If it does not exist, it will be downloaded from the data center
@@ -25,7 +25,7 @@ else
 fi
 
 # Compile the circuit
-circom ${CIRCUIT}.circom --r1cs --wasm --sym --c
+./compile.sh ${CIRCUIT}
 
 # Generate the witness.wtns
 node ${CIRCUIT}_js/generate_witness.js ${CIRCUIT}_js/${CIRCUIT}.wasm input.json ${CIRCUIT}_js/witness.wtns
@@ -44,11 +44,21 @@ snarkjs zkey export verificationkey ${CIRCUIT}_final.zkey verification_key.json
 
 echo "----- Generate zk-proof -----"
 # Generate a zk-proof associated to the circuit and the witness. This generates proof.json and public.json
-snarkjs groth16 prove ${CIRCUIT}_final.zkey ${CIRCUIT}_js/witness.wtns proof.json public.json
+# The native prover is used when it has been built with "make prover" in sudoku_cpp
+if [ -x ./sudoku_cpp/prover ]; then
+    ./sudoku_cpp/prover ${CIRCUIT}_final.zkey ${CIRCUIT}_js/witness.wtns proof.json public.json
+else
+    snarkjs groth16 prove ${CIRCUIT}_final.zkey ${CIRCUIT}_js/witness.wtns proof.json public.json
+fi
 
 echo "----- Verify the proof -----"
 # Verify the proof
-snarkjs groth16 verify verification_key.json public.json proof.json
+# The native verifier is used when it has been built with "make batch_verify" in sudoku_cpp
+if [ -x ./sudoku_cpp/batch_verify ]; then
+    ./sudoku_cpp/batch_verify verification_key.json proof.json public.json
+else
+    snarkjs groth16 verify verification_key.json public.json proof.json
+fi
 
 echo "----- Generate Solidity verifier -----"
 # Generate a Solidity verifier that allows verifying proofs on Ethereum blockchain
@@ -0,0 +1,82 @@
+pragma circom 2.0.0;
+include "../node_modules/circomlib/circuits/comparators.circom";
+
+// Checks that the N inputs are a permutation of 1..N. SubgroupVerifier picks
+// one of these per build, see subgroupCheck in
+// sudoku_templates.circom.
+
+// counts the occurrences of each number with an unconstrained hint and
+// checks every count is 1, N IsEqual (2N constraints)
+// NOTE: occ is not tied to in by any constraint, so this only holds for an
+// honest prover
+template CountingPermutation(N) {
+    signal input in[N];
+
+    // initialize the occurrences array
+    var occurrences[N];
+    for (var i = 0; i < N; i++) {
+        occurrences[i] = 0;
+    }
+
+    // count the occurrences
+    for (var i = 0; i < N; i++) {
+        occurrences[in[i]-1] += 1;
+    }
+
+    // each number must occur exactly once
+    component zeroCheckers[N];
+    signal occ[N];
+    for (var i = 0; i < N; i++) {
+        zeroCheckers[i] = IsEqual();
+        occ[i] <-- occurrences[i];
+        zeroCheckers[i].in[0] <== occ[i];
+        zeroCheckers[i].in[1] <== 1;
+        zeroCheckers[i].out === 1;
+    }
+}
+
+// hot[i][k] is 1 iff in[i] == k + 1, each row and each column of the
+// indicator matrix has a single 1. Sound on its own, without range checks
+// on the inputs (N*N constraints)
+template OneHotPermutation(N) {
+    signal input in[N];
+
+    signal hot[N][N];
+    for (var i = 0; i < N; i++) {
+        var count = 0;
+        var value = 0;
+        for (var k = 0; k < N; k++) {
+            hot[i][k] <-- in[i] == k + 1 ? 1 : 0;
+            hot[i][k] * (hot[i][k] - 1) === 0;
+            count += hot[i][k];
+            value += (k + 1) * hot[i][k];
+        }
+        count === 1;
+        value === in[i];
+    }
+
+    for (var k = 0; k < N; k++) {
+        var uses = 0;
+        for (var i = 0; i < N; i++) {
+            uses += hot[i][k];
+        }
+        uses === 1;
+    }
+}
+
+// N pairwise distinct numbers in 1..N are a permutation of 1..N, each pair
+// proves in[i] - in[j] has an inverse. The caller must range check the
+// inputs (N*(N-1)/2 constraints)
+template DistinctPermutation(N) {
+    signal input in[N];
+
+    signal inv[N*(N-1)\2];
+    var pair = 0;
+    for (var i = 0; i < N; i++) {
+        for (var j = i + 1; j < N; j++) {
+            inv[pair] <-- in[i] != in[j] ? 1 / (in[i] - in[j]) : 0;
+            (in[i] - in[j]) * inv[pair] === 1;
+            pair++;
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+#include "verifier.hpp"
+
+/*
+Native replacement of "snarkjs groth16 verify" for any number of proofs of
+the same key, verified as one batch. Prints OK or the proofs that are
+invalid, and exits with an error when one of them is. --bench verifies the
+proofs the given number of times one by one and as a batch and prints the
+proofs per second of both.
+
+    batch_verify <verification_key.json> <proof.json> <public.json> [<proof.json> <public.json> ...] [--threads <n>] [--bench <iterations>]
+*/
+
+static double since(std::chrono::high_resolution_clock::time_point start) {
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end-start).count();
+}
+
+int main(int argc, char *argv[]) {
+  std::string cl(argv[0]);
+  uint nThreads = std::thread::hardware_concurrency();
+  if (nThreads == 0) nThreads = 1;
+  uint benchIterations = 0;
+  std::vector<std::string> files;
+  bool badArgs = false;
+  for (int i = 2; i < argc; i++) {
+    std::string opt(argv[i]);
+    if (opt == "--threads" && i+1 < argc) {
+      nThreads = atoi(argv[++i]);
+    } else if (opt == "--bench" && i+1 < argc) {
+      benchIterations = atoi(argv[++i]);
+    } else if (opt.compare(0, 2, "--") == 0) {
+      badArgs = true;
+    } else {
+      files.push_back(opt);
+    }
+  }
+  if (argc < 4 || badArgs || files.empty() || files.size() % 2) {
+    std::cout << "Usage: " << cl << " <verification_key.json> <proof.json> <public.json> [<proof.json> <public.json> ...] [--threads <n>] [--bench <iterations>]\n";
+    return EXIT_FAILURE;
+  }
+
+  Groth16_VerificationKey vk;
+  const uint64_t n = files.size()/2;
+  std::vector<Groth16_Proof> proofs(n);
+  std::vector<std::vector<FrValue>> publics(n);
+  std::vector<bool> readable(n, true);
+  try {
+    Groth16_readVerificationKey(argv[1], vk);
+  } catch (std::exception &e) {
+    std::cerr << argv[1] << ": " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (uint64_t i = 0; i < n; i++) {
+    try {
+      Groth16_readProof(files[2*i], proofs[i]);
+      Groth16_readPublic(files[2*i+1], publics[i]);
+    } catch (std::exception &e) {
+      // stays in the batch as the empty proof, which fails
+      std::cerr << files[2*i] << ": " << e.what() << std::endl;
+      readable[i] = false;
+      publics[i].clear();
+    }
+  }
+
+  auto t_start = std::chrono::high_resolution_clock::now();
+  std::vector<bool> valid;
+  bool ok = Groth16_verifyBatch(vk, &proofs[0], &publics[0], n, nThreads, &valid);
+  double verify = since(t_start);
+
+  for (uint64_t i = 0; i < n; i++) {
+    if (!readable[i]) ok = false;
+    if (!valid[i] || !readable[i]) std::cout << "INVALID " << files[2*i] << " " << files[2*i+1] << std::endl;
+  }
+
+  std::cout << std::fixed << std::setprecision(3);
+  if (benchIterations > 0) {
+    t_start = std::chrono::high_resolution_clock::now();
+    for (uint it = 0; it < benchIterations; it++) {
+      for (uint64_t i = 0; i < n; i++) Groth16_verify(vk, proofs[i], publics[i]);
+    }
+    double single = since(t_start);
+
+    t_start = std::chrono::high_resolution_clock::now();
+    for (uint it = 0; it < benchIterations; it++) {
+      Groth16_verifyBatch(vk, &proofs[0], &publics[0], n, 1);
+    }
+    double batch = since(t_start);
+
+    t_start = std::chrono::high_resolution_clock::now();
+    for (uint it = 0; it < benchIterations; it++) {
+      Groth16_verifyBatch(vk, &proofs[0], &publics[0], n, nThreads);
+    }
+    double batchThreads = since(t_start);
+
+    const double total = (double)n*benchIterations;
+    std::cout << "proofs: " << n << ", threads: " << nThreads << ", iterations: " << benchIterations << std::endl;
+    std::cout << "one by one:           " << total*1000/single << " proofs/s" << std::endl;
+    std::cout << "batch, 1 thread:      " << total*1000/batch << " proofs/s" << std::endl;
+    std::cout << "batch, " << std::setw(2) << nThreads << " threads:    " << total*1000/batchThreads << " proofs/s" << std::endl;
+  } else {
+    std::cout << "verify " << verify << " ms" << std::endl;
+  }
+
+  if (!ok) return EXIT_FAILURE;
+  std::cout << "OK" << std::endl;
+  return 0;
+}
@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "fr.hpp"
+
+/*
+Benchmarks the RawFr exponentiation paths against the 4 bit fixed window
+loop RawFr::exp used before, and checks they all give the same results.
+
+    bench_fr [iterations]
+*/
+
+#define BIT_IS_SET(s, p) (s[p>>3] & (1 << (p & 0x7)))
+#define NIBBLE(s, p) ((s[p>>1] >> ((p & 0x1)*4)) & 0xF)
+
+static RawFr &F = RawFr::field;
+
+// The previous RawFr::exp loop
+static void expFixedWindow(RawFr::Element &r, RawFr::Element &base, uint8_t* scalar, unsigned int scalarSize) {
+    int nBits = scalarSize*8;
+    while (nBits>0 && !BIT_IS_SET(scalar, (nBits-1))) nBits--;
+    if (nBits == 0) {
+        F.copy(r, F.one());
+        return;
+    }
+    RawFr::Element table[16];
+    RawFr::Element res;
+    F.copy(table[1], base);
+    for (int i=2; i<16; i++) F.mul(table[i], table[i-1], base);
+
+    int i = (nBits-1) >> 2;
+    F.copy(res, table[NIBBLE(scalar, i)]);
+    for (i--; i>=0; i--) {
+        F.square(res, res);
+        F.square(res, res);
+        F.square(res, res);
+        F.square(res, res);
+        int w = NIBBLE(scalar, i);
+        if (w) F.mul(res, res, table[w]);
+    }
+    F.copy(r, res);
+}
+
+static uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t rng() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+// Random exponent below 2^253
+static void randomScalar(FrRawElement s) {
+    for (int i=0; i<Fr_N64; i++) s[i] = rng();
+    s[Fr_N64-1] &= 0x1FFFFFFFFFFFFFFFULL;
+}
+
+static void randomElement(RawFr::Element &e) {
+    RawFr::Element h;
+    F.fromUI(e, rng());
+    F.fromUI(h, rng());
+    F.mul(e, e, h);
+    F.mul(e, e, e);
+}
+
+template <typename Fn>
+static double timeNs(uint n, Fn fn) {
+    auto t_start = std::chrono::high_resolution_clock::now();
+    for (uint i = 0; i < n; i++) fn(i);
+    auto t_end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(t_end-t_start).count() / n;
+}
+
+static void report(std::string name, double ns, double baseNs) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::setw(12) << ns << " ns"
+              << std::setw(10) << baseNs/ns << "x" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    uint n = argc > 1 ? atoi(argv[1]) : 2000;
+    if (n == 0) n = 1;
+
+    std::vector<RawFr::Element> bases(n);
+    std::vector<RawFr::Element> results(n);
+    std::vector<RawFr::Element> check(n);
+    std::vector<FrRawElement> scalars(n);
+    for (uint i = 0; i < n; i++) {
+        randomElement(bases[i]);
+        randomScalar(scalars[i]);
+    }
+    int bad = 0;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "iterations: " << n << std::endl;
+
+    // Variable base, variable exponent
+    double tOld = timeNs(n, [&](uint i) {
+        expFixedWindow(check[i], bases[i], (uint8_t *)scalars[i], Fr_N64*8);
+    });
+    double tSliding = timeNs(n, [&](uint i) {
+        F.exp(results[i], bases[i], (uint8_t *)scalars[i], Fr_N64*8);
+    });
+    for (uint i = 0; i < n; i++) bad += !F.eq(results[i], check[i]);
+    report("exp fixed window (old)", tOld, tOld);
+    report("exp sliding window", tSliding, tOld);
+
+    // Fixed base, the table is built once outside the timed loop
+    RawFr::FixedBase *fb = F.registerFixedBase(bases[0]);
+    double tFixedOld = timeNs(n, [&](uint i) {
+        expFixedWindow(check[i], bases[0], (uint8_t *)scalars[i], Fr_N64*8);
+    });
+    double tFixed = timeNs(n, [&](uint i) {
+        F.exp(results[i], fb, (uint8_t *)scalars[i], Fr_N64*8);
+    });
+    for (uint i = 0; i < n; i++) bad += !F.eq(results[i], check[i]);
+    report("fixed base (old loop)", tFixedOld, tFixedOld);
+    report("fixed base table", tFixed, tFixedOld);
+
+    // Inversion, mpz_invert is what RawFr::inv uses
+    FrRawElement qMinus2;
+    Fr_rawCopy(qMinus2, Fr_rawq);
+    qMinus2[0] -= 2;
+    double tInvOld = timeNs(n, [&](uint i) {
+        expFixedWindow(check[i], bases[i], (uint8_t *)qMinus2, Fr_N64*8);
+    });
+    double tInvMpz = timeNs(n, [&](uint i) {
+        F.inv(results[i], bases[i]);
+    });
+    for (uint i = 0; i < n; i++) bad += !F.eq(results[i], check[i]);
+    double tInvPlan = timeNs(n, [&](uint i) {
+        F.invExp(results[i], bases[i]);
+    });
+    for (uint i = 0; i < n; i++) bad += !F.eq(results[i], check[i]);
+    report("inv a^(q-2) (old loop)", tInvOld, tInvOld);
+    report("inv mpz_invert", tInvMpz, tInvOld);
+    report("inv a^(q-2) cached plan", tInvPlan, tInvOld);
+
+    if (bad) {
+        std::cerr << bad << " mismatching results" << std::endl;
+        return 1;
+    }
+    return 0;
+}
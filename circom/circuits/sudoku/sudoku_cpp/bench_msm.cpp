@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "msm.hpp"
+#include "sudoku_native.hpp"
+
+/*
+Multi scalar multiplications on the signals of a 9x9 Sudoku witness, the
+scalars of the A, B and C MSMs of a proof, and on random scalars of the
+same count. Compares msm against msm_generic in G1 and G2 with one thread
+and with all of them, and checks they give the same point.
+
+    bench_msm [iterations]
+*/
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static double ms(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now()-start).count();
+}
+
+// n points k*g, k*g + step, ..., in affine form
+template <class F>
+static std::vector<CurveAffine<F>> points(const CurvePoint<F> &g, u64 n) {
+  std::vector<CurveAffine<F>> r(n);
+  CurvePoint<F> p = g.mul(FrValue(0x9e3779b97f4a7c15ULL));
+  CurvePoint<F> step = g.mul(FrValue(0xbf58476d1ce4e5b9ULL));
+  for (u64 i = 0; i < n; i++) {
+    r[i] = p.toAffine();
+    p += step;
+  }
+  return r;
+}
+
+template <class F>
+static bool bench(const char *name, const std::vector<CurveAffine<F>> &bases, const std::vector<uint64_t> &scalars,
+                  uint iterations, uint nThreads) {
+  const u64 n = bases.size();
+  CurvePoint<F> expected = msm_generic(&bases[0], &scalars[0], n, 1);
+  bool ok = true;
+
+  double t[4];
+  for (int k = 0; k < 4; k++) {
+    uint threads = k & 1 ? nThreads : 1;
+    auto t_start = Clock::now();
+    for (uint i = 0; i < iterations; i++) {
+      CurvePoint<F> r = k < 2 ? msm_generic(&bases[0], &scalars[0], n, threads) : msm(&bases[0], &scalars[0], n, threads);
+      ok &= r == expected;
+    }
+    t[k] = ms(t_start) / iterations;
+  }
+
+  std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << t[0] << std::setw(12) << t[1]
+            << std::setw(12) << t[2] << std::setw(12) << t[3]
+            << std::setw(9) << std::setprecision(2) << t[0]/t[2] << "x" << std::endl;
+  return ok;
+}
+
+int main(int argc, char *argv[]) {
+  uint iterations = argc > 1 ? atoi(argv[1]) : 3;
+  if (iterations == 0) iterations = 1;
+  uint nThreads = std::thread::hardware_concurrency();
+  if (nThreads == 0) nThreads = 1;
+
+  // Every signal of a 9x9 witness, in normal form
+  const u64 signals = sudoku_native_signal_no(3);
+  std::vector<u32> slots(signals);
+  for (u64 i = 0; i < signals; i++) slots[i] = i;
+  Circom_SignalStore store(signals, &slots[0], signals);
+  std::vector<int> unsolved(81), solved(81);
+  sudoku_random_board(1, 3, &unsolved[0], &solved[0]);
+  bool ok = sudoku_native_witness<3>(store, &unsolved[0], &solved[0]);
+
+  std::vector<uint64_t> witness(signals*Fr_N64), random(signals*Fr_N64);
+  u64 zeros = 0, ones = 0, small = 0;
+  FrElement v;
+  for (u64 i = 0; i < signals; i++) {
+    store.get(i, &v);
+    Fr_toLongNormal(&v, &v);
+    for (int k = 0; k < Fr_N64; k++) witness[i*Fr_N64 + k] = v.longVal[k];
+    const uint64_t *s = &witness[i*Fr_N64];
+    if (s[1] | s[2] | s[3]) continue;
+    if (s[0] == 0) zeros++;
+    else if (s[0] == 1) ones++;
+    else small++;
+  }
+
+  std::mt19937_64 rng(1);
+  for (u64 i = 0; i < signals; i++) {
+    uint64_t *s = &random[i*Fr_N64];
+    for (int k = 0; k < Fr_N64; k++) s[k] = rng();
+    s[Fr_N64-1] &= 0x1FFFFFFFFFFFFFFFULL;
+  }
+
+  std::vector<G1Affine> g1 = points(G1_generator(), signals);
+  std::vector<G2Affine> g2 = points(G2_generator(), signals);
+
+  std::cout << "points: " << signals << ", threads: " << nThreads << ", iterations: " << iterations << std::endl;
+  std::cout << "witness scalars: " << zeros << " zero, " << ones << " one, " << small << " below 2^64, "
+            << signals - zeros - ones - small << " full" << std::endl;
+  std::cout << std::left << std::setw(24) << "ms per MSM" << std::right
+            << std::setw(12) << "generic 1" << std::setw(12) << "generic all"
+            << std::setw(12) << "msm 1" << std::setw(12) << "msm all" << std::setw(10) << "speedup" << std::endl;
+  ok &= bench("G1, Sudoku witness", g1, witness, iterations, nThreads);
+  ok &= bench("G1, random scalars", g1, random, iterations, nThreads);
+  ok &= bench("G2, Sudoku witness", g2, witness, iterations, nThreads);
+
+  if (!ok) {
+    std::cerr << "msm differs from msm_generic" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+#include "sudoku_native.hpp"
+
+/*
+Scaling benchmark of the native witness engine. For every board size it
+computes the signals of random boards with the code compiled for the size
+and with the run time size code, checks both write the same signals, and
+reports the time per witness and the memory of the signal store. Then it
+fills 9x9 SudokuBatch(K, 3, 9) witnesses with one thread and with all of
+them, and reports the time per board.
+
+    bench_native [iterations]
+*/
+
+#define BOARDS 16
+
+static bool sameSignals(const Circom_SignalStore &a, const Circom_SignalStore &b, u64 n) {
+  FrElement va = {}, vb = {};
+  for (u64 i = 0; i < n; i++) {
+    a.get(i, &va);
+    b.get(i, &vb);
+    if (va.type != vb.type) return false;
+    if (va.type & Fr_LONG) {
+      for (int k = 0; k < Fr_N64; k++) if (va.longVal[k] != vb.longVal[k]) return false;
+    } else if (va.shortVal != vb.shortVal) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <uint SQRTN>
+static bool benchSize(uint iterations) {
+  const uint n = SQRTN*SQRTN;
+  const u64 signals = sudoku_native_signal_no(SQRTN);
+
+  // Every signal has its own slot, there is no compiled circuit to take the
+  // witness list from
+  std::vector<u32> slots(signals);
+  for (u64 i = 0; i < signals; i++) slots[i] = i;
+  Circom_SignalStore fixed(signals, &slots[0], signals);
+  Circom_SignalStore runtime(signals, &slots[0], signals);
+
+  std::vector<int> unsolved(BOARDS*n*n), solved(BOARDS*n*n);
+  for (uint b = 0; b < BOARDS; b++) {
+    sudoku_random_board(b + 1, SQRTN, &unsolved[b*n*n], &solved[b*n*n]);
+  }
+
+  // The first run also builds the IsZero inverses table
+  bool ok = sudoku_native_witness<SQRTN>(fixed, &unsolved[0], &solved[0]);
+  auto t_start = std::chrono::high_resolution_clock::now();
+  for (uint i = 0; i < iterations; i++) {
+    uint b = i % BOARDS;
+    ok &= sudoku_native_witness<SQRTN>(fixed, &unsolved[b*n*n], &solved[b*n*n]);
+  }
+  auto t_mid = std::chrono::high_resolution_clock::now();
+  for (uint i = 0; i < iterations; i++) {
+    uint b = i % BOARDS;
+    ok &= sudoku_native_witness(SQRTN, runtime, &unsolved[b*n*n], &solved[b*n*n]);
+  }
+  auto t_end = std::chrono::high_resolution_clock::now();
+  ok &= sameSignals(fixed, runtime, signals);
+
+  // Memory of the store of a single witness, a reused store keeps the pool
+  // entries of signals that were long on an earlier board
+  Circom_SignalStore single(signals, &slots[0], signals);
+  ok &= sudoku_native_witness<SQRTN>(single, &unsolved[0], &solved[0]);
+
+  double tFixed = std::chrono::duration<double, std::micro>(t_mid-t_start).count() / iterations;
+  double tRuntime = std::chrono::duration<double, std::micro>(t_end-t_mid).count() / iterations;
+  std::cout << std::setw(3) << n << "x" << std::left << std::setw(3) << n << std::right
+            << std::setw(10) << signals
+            << std::setw(12) << tFixed << " us"
+            << std::setw(12) << tRuntime << " us"
+            << std::setw(10) << single.memoryUsage()/1024 << " KiB"
+            << std::setw(10) << (u64)signals*sizeof(FrElement)/1024 << " KiB" << std::endl;
+  return ok;
+}
+
+static bool benchBatch(uint boards, uint iterations, uint nThreads) {
+  const uint cells = 81;
+  const u64 signals = sudoku_native_batch_signal_no(3, boards);
+
+  std::vector<u32> slots(signals);
+  for (u64 i = 0; i < signals; i++) slots[i] = i;
+  Circom_SignalStore serial(signals, &slots[0], signals);
+  Circom_SignalStore parallel(signals, &slots[0], signals);
+
+  std::vector<int> unsolved(boards*cells), solved(boards*cells);
+  for (uint b = 0; b < boards; b++) {
+    sudoku_random_board(b + 1, 3, &unsolved[b*cells], &solved[b*cells]);
+  }
+
+  bool ok = true;
+  auto t_start = std::chrono::high_resolution_clock::now();
+  for (uint i = 0; i < iterations; i++) {
+    ok &= sudoku_native_batch_witness(3, boards, serial, &unsolved[0], &solved[0], 1);
+  }
+  auto t_mid = std::chrono::high_resolution_clock::now();
+  for (uint i = 0; i < iterations; i++) {
+    ok &= sudoku_native_batch_witness(3, boards, parallel, &unsolved[0], &solved[0], nThreads);
+  }
+  auto t_end = std::chrono::high_resolution_clock::now();
+  ok &= sameSignals(serial, parallel, signals);
+
+  double tSerial = std::chrono::duration<double, std::micro>(t_mid-t_start).count() / iterations / boards;
+  double tParallel = std::chrono::duration<double, std::micro>(t_end-t_mid).count() / iterations / boards;
+  std::cout << std::setw(5) << boards
+            << std::setw(12) << signals
+            << std::setw(12) << tSerial << " us"
+            << std::setw(12) << tParallel << " us" << std::endl;
+  return ok;
+}
+
+int main(int argc, char *argv[]) {
+  uint iterations = argc > 1 ? atoi(argv[1]) : 200;
+  if (iterations == 0) iterations = 1;
+
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "iterations: " << iterations << std::endl;
+  std::cout << "board      signals    compiled size   run time size     store  as FrElement" << std::endl;
+  bool ok = benchSize<2>(iterations);
+  ok &= benchSize<3>(iterations);
+  ok &= benchSize<4>(iterations);
+  ok &= benchSize<5>(iterations);
+
+  if (!ok) {
+    std::cerr << "the compiled and run time size engines differ" << std::endl;
+    return 1;
+  }
+
+  uint nThreads = std::thread::hardware_concurrency();
+  if (nThreads == 0) nThreads = 1;
+  uint batchIterations = iterations/16 ? iterations/16 : 1;
+  std::cout << std::endl << "threads: " << nThreads << ", iterations: " << batchIterations << std::endl;
+  std::cout << "    K     signals   1 thread/board   threads/board" << std::endl;
+  ok = benchBatch(1, batchIterations, nThreads);
+  ok &= benchBatch(4, batchIterations, nThreads);
+  ok &= benchBatch(16, batchIterations, nThreads);
+  ok &= benchBatch(64, batchIterations, nThreads);
+
+  if (!ok) {
+    std::cerr << "the serial and parallel batch engines differ" << std::endl;
+    return 1;
+  }
+  return 0;
+}
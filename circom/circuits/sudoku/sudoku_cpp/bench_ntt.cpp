@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+#include "ntt.hpp"
+
+/*
+Times of the Ntt transforms for domains of 2^12 to 2^maxBits elements
+against a plain radix-2 FFT that computes its roots on every call, with one
+thread and with all of them. Checks the transforms against the radix-2 one
+and against the direct evaluation on a small domain, and that the inverse
+gives the input back.
+
+    bench_ntt [maxBits]
+*/
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static RawFr &F = RawFr::field;
+
+static double ms(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now()-start).count();
+}
+
+// The textbook iterative FFT, the baseline
+static void fftRadix2(RawFr::Element *a, unsigned bits) {
+  const uint64_t n = (uint64_t)1 << bits;
+  for (uint64_t i = 1, j = 0; i < n; i++) {
+    uint64_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) F.swap(a[i], a[j]);
+  }
+  RawFr::Element w, wLen, t;
+  for (unsigned s = 1; s <= bits; s++) {
+    const uint64_t half = (uint64_t)1 << (s - 1);
+    F.fromValue(wLen, Ntt::root(s));
+    for (uint64_t i = 0; i < n; i += 2*half) {
+      F.copy(w, F.one());
+      for (uint64_t k = 0; k < half; k++) {
+        F.mul(t, w, a[i + k + half]);
+        F.sub(a[i + k + half], a[i + k], t);
+        F.add(a[i + k], a[i + k], t);
+        F.mul(w, w, wLen);
+      }
+    }
+  }
+}
+
+static bool same(const std::vector<RawFr::Element> &a, const std::vector<RawFr::Element> &b) {
+  for (uint64_t i = 0; i < a.size(); i++) if (!F.eq(const_cast<RawFr::Element &>(a[i]), const_cast<RawFr::Element &>(b[i]))) return false;
+  return true;
+}
+
+// p(w^i) computed directly on 2^bits elements
+static bool checkDirect(unsigned bits) {
+  const uint64_t n = (uint64_t)1 << bits;
+  std::vector<RawFr::Element> a(n), direct(n);
+  for (uint64_t i = 0; i < n; i++) F.fromUI(a[i], 3*i + 1);
+  RawFr::Element w, x, t;
+  F.fromValue(w, Ntt::root(bits));
+  F.copy(x, F.one());
+  for (uint64_t i = 0; i < n; i++) {
+    // Horner at x = w^i
+    F.copy(direct[i], F.zero());
+    for (uint64_t k = n; k-- > 0;) {
+      F.mul(t, direct[i], x);
+      F.add(direct[i], t, a[k]);
+    }
+    F.mul(x, x, w);
+  }
+  Ntt::get(bits).fft(&a[0]);
+  return same(a, direct);
+}
+
+int main(int argc, char *argv[]) {
+  unsigned maxBits = argc > 1 ? atoi(argv[1]) : 20;
+  uint nThreads = std::thread::hardware_concurrency();
+  if (nThreads == 0) nThreads = 1;
+
+  bool ok = checkDirect(1) && checkDirect(2) && checkDirect(5) && checkDirect(6);
+
+  std::cout << "threads: " << nThreads << std::endl;
+  std::cout << std::setw(6) << "size" << std::setw(14) << "radix-2 ms" << std::setw(14) << "fft 1 ms"
+            << std::setw(14) << "fft all ms" << std::setw(14) << "ifft all ms" << std::setw(10) << "speedup" << std::endl;
+  for (unsigned bits = 12; bits <= maxBits; bits++) {
+    const uint64_t n = (uint64_t)1 << bits;
+    std::vector<RawFr::Element> input(n), ref(n), a(n);
+    for (uint64_t i = 0; i < n; i++) F.fromUI(input[i], i*i + 7);
+    const Ntt &ntt = Ntt::get(bits);
+
+    ref = input;
+    auto t_start = Clock::now();
+    fftRadix2(&ref[0], bits);
+    double tRadix2 = ms(t_start);
+
+    a = input;
+    t_start = Clock::now();
+    ntt.fft(&a[0], 1);
+    double tOne = ms(t_start);
+    ok &= same(a, ref);
+
+    a = input;
+    t_start = Clock::now();
+    ntt.fft(&a[0], nThreads);
+    double tAll = ms(t_start);
+    ok &= same(a, ref);
+
+    t_start = Clock::now();
+    ntt.ifft(&a[0], nThreads);
+    double tInv = ms(t_start);
+    ok &= same(a, input);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(4) << "2^" << std::left << std::setw(2) << bits << std::right
+              << std::setw(14) << tRadix2 << std::setw(14) << tOne
+              << std::setw(14) << tAll << std::setw(14) << tInv
+              << std::setw(9) << tRadix2/tOne << "x" << std::endl;
+  }
+
+  if (!ok) {
+    std::cerr << "Ntt differs from the radix-2 FFT or the direct evaluation" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+#include "sudoku_native.hpp"
+
+/*
+Throughput of the native Poseidon and of the CommittedSudoku commitments:
+Poseidon(2) one hash at a time and in batches, then the commitments of
+random 9x9 puzzles with one thread and with all of them. Checks the hash
+against the circomlib test vector and the batches against single hashes.
+
+    bench_poseidon [hashes]
+*/
+
+static RawFr &F = RawFr::field;
+
+static double perSecond(std::chrono::high_resolution_clock::time_point start, u64 count) {
+  auto end = std::chrono::high_resolution_clock::now();
+  return count / std::chrono::duration<double>(end-start).count();
+}
+
+int main(int argc, char *argv[]) {
+  u64 hashes = argc > 1 ? atoll(argv[1]) : 100000;
+  if (hashes < POSEIDON_LANES) hashes = POSEIDON_LANES;
+  uint nThreads = std::thread::hardware_concurrency();
+  if (nThreads == 0) nThreads = 1;
+
+  // circomlib poseidon([1, 2])
+  const Poseidon &poseidon = Poseidon::get(2);
+  RawFr::Element in[2], r, expected;
+  F.fromUI(in[0], 1);
+  F.fromUI(in[1], 2);
+  F.fromString(expected, "7853200120776062878684798364095072458815029376092732009249414926327459813530");
+  poseidon.hash(r, in);
+  bool ok = F.eq(r, expected);
+
+  std::vector<RawFr::Element> inputs(2*hashes), single(hashes), batch(hashes);
+  for (u64 i = 0; i < 2*hashes; i++) F.fromUI(inputs[i], i + 1);
+
+  auto t_start = std::chrono::high_resolution_clock::now();
+  for (u64 i = 0; i < hashes; i++) poseidon.hash(single[i], &inputs[2*i]);
+  double hashRate = perSecond(t_start, hashes);
+
+  t_start = std::chrono::high_resolution_clock::now();
+  poseidon.hashBatch(&batch[0], &inputs[0], hashes, 1);
+  double batchRate = perSecond(t_start, hashes);
+  for (u64 i = 0; i < hashes; i++) ok &= F.eq(single[i], batch[i]);
+
+  t_start = std::chrono::high_resolution_clock::now();
+  poseidon.hashBatch(&batch[0], &inputs[0], hashes, nThreads);
+  double threadsRate = perSecond(t_start, hashes);
+  for (u64 i = 0; i < hashes; i++) ok &= F.eq(single[i], batch[i]);
+
+  // Commitments of random 9x9 puzzles, packing included
+  std::vector<int> unsolved(hashes*81), solved(hashes*81);
+  for (u64 b = 0; b < hashes; b++) sudoku_random_board(b + 1, 3, &unsolved[b*81], &solved[b*81]);
+  std::vector<RawFr::Element> commitments(hashes);
+
+  t_start = std::chrono::high_resolution_clock::now();
+  sudoku_commitment_batch(3, hashes, &unsolved[0], &commitments[0], 1);
+  double commitRate = perSecond(t_start, hashes);
+
+  t_start = std::chrono::high_resolution_clock::now();
+  sudoku_commitment_batch(3, hashes, &unsolved[0], &commitments[0], nThreads);
+  double commitThreadsRate = perSecond(t_start, hashes);
+  sudoku_commitment(3, &unsolved[(hashes-1)*81], r);
+  ok &= F.eq(r, commitments[hashes-1]);
+
+  std::cout << std::fixed << std::setprecision(0);
+  std::cout << "hashes: " << hashes << ", threads: " << nThreads << std::endl;
+  std::cout << "Poseidon(2) one by one:      " << std::setw(10) << hashRate << " hashes/s" << std::endl;
+  std::cout << "Poseidon(2) batch, 1 thread: " << std::setw(10) << batchRate << " hashes/s" << std::endl;
+  std::cout << "Poseidon(2) batch, threads:  " << std::setw(10) << threadsRate << " hashes/s" << std::endl;
+  std::cout << "9x9 commitments, 1 thread:   " << std::setw(10) << commitRate << " boards/s" << std::endl;
+  std::cout << "9x9 commitments, threads:    " << std::setw(10) << commitThreadsRate << " boards/s" << std::endl;
+
+  if (!ok) {
+    std::cerr << "Poseidon differs from circomlib or between batch and single hashes" << std::endl;
+    return 1;
+  }
+  return 0;
+}
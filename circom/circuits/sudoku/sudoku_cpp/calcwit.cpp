@@ -1,9 +1,13 @@
 #include <iomanip>
 #include <sstream>
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 #include "calcwit.hpp"
 
 extern void run(Circom_CalcWit* ctx);
+extern Circom_TemplateFunction _functionTable[];
+extern bool run_native(Circom_CalcWit* ctx);
 
 std::string int_to_hex( u64 i )
 {
@@ -23,20 +27,148 @@ u64 fnv1a(std::string s) {
   return hash;
 }
 
-Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
+Circom_SignalStore::Circom_SignalStore(u64 n, const u32 *signalSlots, u64 ownSlots) {
+  nSlots = n;
+  nOwnSlots = ownSlots;
+  slotOf = signalSlots;
+  slots = new Circom_SignalSlot[n]();
+  longOf = new u32[n];
+  for (u64 i = 0; i < n; i++) longOf[i] = SIGNAL_NO_LONG;
+  poolSize = 0;
+  for (uint c = 0; c < SIGNAL_POOL_MAX_CHUNKS; c++) pool[c] = nullptr;
+  pool[0] = (u64 *)aligned_alloc(32, (size_t)Fr_N64*8 << SIGNAL_POOL_CHUNK_BITS);
+}
+
+Circom_SignalStore::~Circom_SignalStore() {
+  delete[] slots;
+  delete[] longOf;
+  for (uint c = 0; c < SIGNAL_POOL_MAX_CHUNKS; c++) free(pool[c].load());
+}
+
+uint Circom_SignalStore::allocLong() {
+  uint idx = poolSize.fetch_add(1);
+  uint chunk = idx >> SIGNAL_POOL_CHUNK_BITS;
+  if (chunk >= SIGNAL_POOL_MAX_CHUNKS) {
+    fprintf(stderr, "Too many long signal values\n");
+    assert(false);
+  }
+  if (!pool[chunk].load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (!pool[chunk].load()) {
+      pool[chunk].store((u64 *)aligned_alloc(32, (size_t)Fr_N64*8 << SIGNAL_POOL_CHUNK_BITS), std::memory_order_release);
+    }
+  }
+  return idx;
+}
+
+void Circom_SignalStore::copyOwnSignals(u64 start, const Circom_SignalStore &src, u64 srcStart, u64 n) {
+  FrElement e;
+  for (u64 i = 0; i < n; i++) {
+    if (slotOf[start + i] >= nOwnSlots) continue;
+    src.get(srcStart + i, &e);
+    set(start + i, &e);
+  }
+}
+
+void Circom_SignalStore::saveBlock(u64 start, uint n, Circom_SignalBlock &b) const {
+  b.slots.resize(n);
+  for (uint i = 0; i < n; i++) b.slots[i] = slots[slotOf[start + i]];
+  b.limbs.clear();
+  for (uint i = 0; i < n; i++) {
+    if (b.slots[i].type & Fr_LONG) {
+      const u64 *l = poolEntry(longOf[slotOf[start + i]]);
+      b.slots[i].shortVal = (int32_t)(b.limbs.size()/Fr_N64);
+      b.limbs.insert(b.limbs.end(), l, l + Fr_N64);
+    }
+  }
+}
+
+void Circom_SignalStore::restoreBlock(u64 start, const Circom_SignalBlock &b) {
+  FrElement e;
+  for (uint i = 0; i < b.slots.size(); i++) {
+    const Circom_SignalSlot &slot = b.slots[i];
+    if (slot.type & Fr_LONG) {
+      e.type = slot.type;
+      for (int k = 0; k < Fr_N64; k++) e.longVal[k] = b.limbs[(u64)(uint32_t)slot.shortVal*Fr_N64 + k];
+      set(start + i, &e);
+    } else {
+      slots[slotOf[start + i]] = slot;
+    }
+  }
+}
+
+u64 Circom_SignalStore::memoryUsage() const {
+  u64 chunks = 0;
+  for (uint c = 0; c < SIGNAL_POOL_MAX_CHUNKS; c++) chunks += pool[c].load() != nullptr;
+  return nSlots*(sizeof(Circom_SignalSlot) + sizeof(u32)) + (chunks*Fr_N64*8 << SIGNAL_POOL_CHUNK_BITS);
+}
+
+#define NO_SLOT 0xFFFFFFFF
+
+// Gives the next scratch slots to the signals of a component of template t
+// at signal start that are outside its subcomponents and not in the witness
+static u64 placeOwnSignals(Circom_Circuit *circuit, uint t, u64 start, u64 slot) {
+  std::vector<bool> own(_templateSignalNo[t], true);
+  for (uint c = _templateSubcomponentStart[t]; c < _templateSubcomponentStart[t+1]; c++) {
+    uint offset = _templateSubcomponents[c][1];
+    for (uint k = 0; k < _templateSignalNo[_templateSubcomponents[c][0]]; k++) own[offset + k] = false;
+  }
+  for (uint k = 0; k < _templateSignalNo[t]; k++) {
+    if (own[k] && circuit->signalSlots[start + k] == NO_SLOT) circuit->signalSlots[start + k] = slot++;
+  }
+  return slot;
+}
+
+// Places the frame of a component of template t at signal start from slot
+// on, then the frames of its subcomponents. Returns the end of the deepest
+// frame.
+static u64 placeFrame(Circom_Circuit *circuit, uint t, u64 start, u64 slot) {
+  u64 frameEnd = slot;
+  for (uint c = _templateSubcomponentStart[t]; c < _templateSubcomponentStart[t+1]; c++) {
+    frameEnd = placeOwnSignals(circuit, _templateSubcomponents[c][0], start + _templateSubcomponents[c][1], frameEnd);
+  }
+  u64 end = frameEnd;
+  for (uint c = _templateSubcomponentStart[t]; c < _templateSubcomponentStart[t+1]; c++) {
+    u64 e = placeFrame(circuit, _templateSubcomponents[c][0], start + _templateSubcomponents[c][1], frameEnd);
+    if (e > end) end = e;
+  }
+  return end;
+}
+
+void Circom_buildSignalLayout(Circom_Circuit *circuit) {
+  u64 nWitness = get_size_of_witness();
+  circuit->signalSlots = new u32[get_total_signal_no()];
+  for (uint i = 0; i < get_total_signal_no(); i++) circuit->signalSlots[i] = NO_SLOT;
+  for (uint w = 0; w < nWitness; w++) circuit->signalSlots[circuit->witness2SignalList[w]] = w;
+  // main starts after the constant one signal
+  uint main = get_main_template_id();
+  u64 slot = placeOwnSignals(circuit, main, 1, nWitness);
+  circuit->slotNo = placeFrame(circuit, main, 1, slot);
+  for (uint i = 0; i < get_total_signal_no(); i++) {
+    if (circuit->signalSlots[i] == NO_SLOT) {
+      fprintf(stderr, "Signal %u is not in the layout\n", i);
+      assert(false);
+    }
+  }
+}
+
+Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) : signalValues(aCircuit->slotNo, aCircuit->signalSlots, get_size_of_witness()) {
   circuit = aCircuit;
   inputSignalAssignedCounter = get_main_input_signal_no();
   inputSignalAssigned = new bool[inputSignalAssignedCounter];
   for (int i = 0; i< inputSignalAssignedCounter; i++) {
     inputSignalAssigned[i] = false;
   }
-  signalValues = new FrElement[get_total_signal_no()];
-  Fr_str2element(&signalValues[0], "1");
-  componentMemory = new Circom_Component[get_number_of_components()];
+  FrElement one;
+  Fr_str2element(&one, "1");
+  signalValues.set(0, &one);
+  componentMemory = new Circom_Component[get_number_of_components()]();
   circuitConstants = circuit ->circuitConstants;
   templateInsId2IOSignalInfo = circuit -> templateInsId2IOSignalInfo;
 
   maxThread = maxTh;
+  nativeEngine = false;
+  memoize = true;
 
   // parallelism
   numThread = 0;
@@ -44,7 +176,11 @@ Circom_CalcWit::Circom_CalcWit (Circom_Circuit *aCircuit, uint maxTh) {
 }
 
 Circom_CalcWit::~Circom_CalcWit() {
-  // ...
+  for (uint i = 0; i < get_number_of_components(); i++) {
+    delete[] componentMemory[i].subcomponents;
+  }
+  delete[] componentMemory;
+  delete[] inputSignalAssigned;
 }
 
 uint Circom_CalcWit::getInputSignalHashPosition(u64 h) {
@@ -83,11 +219,14 @@ void Circom_CalcWit::setInputSignal(u64 h, uint i,  FrElement & val){
     fprintf(stderr, "Signal assigned twice: %d\n", si);
     assert(false);
   }
-  signalValues[si] = val;
+  signalValues.set(si, &val);
   inputSignalAssigned[si-get_main_input_signal_start()] = true;
   inputSignalAssignedCounter--;
   if (inputSignalAssignedCounter == 0) {
-    run(this);
+    if (!(nativeEngine && run_native(this))) {
+      nativeEngine = false;
+      run(this);
+    }
   }
 }
 
@@ -96,6 +235,57 @@ u64 Circom_CalcWit::getInputSignalSize(u64 h) {
   return circuit->InputHashMap[pos].signalsize;
 }
 
+// Key of template id and input values, only short inputs are cached
+bool Circom_CalcWit::memoKey(std::string &key, uint cIdx) {
+  const Circom_Component &c = componentMemory[cIdx];
+  key.assign((const char *)&c.templateId, sizeof(c.templateId));
+  FrElement v;
+  for (uint i = 0; i < _templateInputNo[c.templateId]; i++) {
+    signalValues.get(c.signalStart + _templateInputStart[c.templateId] + i, &v);
+    if (v.type & Fr_LONG) return false;
+    key.append((const char *)&v.shortVal, sizeof(v.shortVal));
+  }
+  return true;
+}
+
+void Circom_CalcWit::runComponent(uint cIdx) {
+  const Circom_Component &c = componentMemory[cIdx];
+  const uint t = c.templateId;
+  if (!memoize || _templateInputNo[t] > MEMO_MAX_INPUTS || _templateSignalNo[t] < MEMO_MIN_SIGNALS) {
+    _functionTable[t](cIdx, this);
+    return;
+  }
+  // The block of a component is contiguous, its subcomponents included
+  std::string key;
+  MemoCounts &counts = memoCounts[c.templateName];
+  if (!memoKey(key, cIdx)) {
+    counts.misses++;
+    _functionTable[t](cIdx, this);
+    return;
+  }
+  auto it = memoBlocks.find(key);
+  if (it != memoBlocks.end()) {
+    signalValues.restoreBlock(c.signalStart, it->second);
+    counts.hits++;
+    return;
+  }
+  counts.misses++;
+  _functionTable[t](cIdx, this);
+  signalValues.saveBlock(c.signalStart, _templateSignalNo[t], memoBlocks[key]);
+}
+
+std::string Circom_CalcWit::memoStats() {
+  std::ostringstream stats;
+  stats << std::fixed << std::setprecision(1);
+  for (auto it = memoCounts.begin(); it != memoCounts.end(); ++it) {
+    u64 total = it->second.hits + it->second.misses;
+    stats << "memo " << it->first << ": " << it->second.hits << " hits, "
+          << it->second.misses << " misses (" << (total ? 100.0*it->second.hits/total : 0.0)
+          << "% hit rate)" << std::endl;
+  }
+  return stats.str();
+}
+
 std::string Circom_CalcWit::getTrace(u64 id_cmp){
   if (id_cmp == 0) return componentMemory[id_cmp].componentName;
   else{
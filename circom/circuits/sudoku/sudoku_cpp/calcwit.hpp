@@ -6,14 +6,171 @@
 #include <functional>
 #include <atomic>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "circom.hpp"
 #include "fr.hpp"
 
 #define NMUTEXES 12 //512
 
+// Long values per pool chunk, and the most chunks a signal store can hold
+#define SIGNAL_POOL_CHUNK_BITS 10
+#define SIGNAL_POOL_CHUNK_MASK ((1 << SIGNAL_POOL_CHUNK_BITS) - 1)
+#define SIGNAL_POOL_MAX_CHUNKS 1024
+#define SIGNAL_NO_LONG 0xFFFFFFFF
+
+// Templates with at most MEMO_MAX_INPUTS inputs and at least MEMO_MIN_SIGNALS
+// signals, subcomponents included, are memoized. Smaller blocks are cheaper
+// to recompute than to look up.
+#define MEMO_MAX_INPUTS 2
+#define MEMO_MIN_SIGNALS 64
+
 u64 fnv1a(std::string s);
 
+/*
+Signal storage. Almost every signal of the circuit is a short value (bits,
+booleans, cell values), so each signal only keeps the 8 byte header of an
+FrElement: the short value and the type. Long values are moved to a pool of
+32 byte aligned limbs. A slot gets its pool entry the first time it holds a
+long value and keeps it in longOf, also while it holds short values, so
+rewriting a signal never takes a new entry and the pool is at most one
+entry per slot. get/set convert from/to the packed FrElement the Fr_*
+functions work on.
+
+The pool grows by chunks that never move, and pool entries are handed out
+by an atomic counter, so several threads can set signals with slots of their
+own at the same time.
+
+Signals are addressed through the slot map of the circuit layout (see
+Circom_buildSignalLayout): witness signals have a slot of their own, the
+other ones share a small scratch area.
+*/
+struct Circom_SignalSlot {
+  int32_t shortVal;
+  uint32_t type;
+};
+
+// Copy of a block of signals, long values keep an index into limbs
+struct Circom_SignalBlock {
+  std::vector<Circom_SignalSlot> slots;
+  std::vector<u64> limbs;
+};
+
+class Circom_SignalStore {
+
+  Circom_SignalSlot *slots;
+  u32 *longOf;
+  const u32 *slotOf;
+  std::atomic<u64 *> pool[SIGNAL_POOL_MAX_CHUNKS];
+  std::atomic<uint> poolSize;
+  std::mutex poolMutex;
+  u64 nSlots;
+  u64 nOwnSlots;
+
+  uint allocLong();
+
+  inline u64 *poolEntry(uint idx) const {
+    return &pool[idx >> SIGNAL_POOL_CHUNK_BITS].load(std::memory_order_relaxed)[(u64)(idx & SIGNAL_POOL_CHUNK_MASK)*Fr_N64];
+  }
+
+  inline u64 *longEntry(u64 slot) {
+    if (longOf[slot] == SIGNAL_NO_LONG) longOf[slot] = allocLong();
+    return poolEntry(longOf[slot]);
+  }
+
+public:
+
+  // Slots below ownSlots belong to a single signal, the other ones are
+  // shared scratch slots
+  Circom_SignalStore(u64 n, const u32 *signalSlots, u64 ownSlots);
+  ~Circom_SignalStore();
+
+  inline void getSlot(u64 slot, PFrElement r) const {
+    Circom_SignalSlot s = slots[slot];
+    r->type = s.type;
+    if (s.type & Fr_LONG) {
+      const u64 *l = poolEntry(longOf[slot]);
+      r->shortVal = 0;
+      for (int k = 0; k < Fr_N64; k++) r->longVal[k] = l[k];
+    } else {
+      r->shortVal = s.shortVal;
+    }
+  }
+
+  inline void get(u64 i, PFrElement r) const {
+    getSlot(slotOf[i], r);
+  }
+
+  // Short montgomery values are stored as plain short values
+  inline void set(u64 i, PFrElement a) {
+    u64 slot = slotOf[i];
+    Circom_SignalSlot &s = slots[slot];
+    if (!(a->type & Fr_LONG)) {
+      s.shortVal = a->shortVal;
+      s.type = Fr_SHORT;
+      return;
+    }
+    u64 *l = longEntry(slot);
+    for (int k = 0; k < Fr_N64; k++) l[k] = a->longVal[k];
+    s.shortVal = 0;
+    s.type = a->type;
+  }
+
+  inline void setShort(u64 i, int32_t v) {
+    Circom_SignalSlot &s = slots[slotOf[i]];
+    s.shortVal = v;
+    s.type = Fr_SHORT;
+  }
+
+  inline void setn(u64 i, PFrElement a, uint n) {
+    for (uint k = 0; k < n; k++) set(i+k, &a[k]);
+  }
+
+  inline void copy(u64 dst, u64 src) {
+    const Circom_SignalSlot &s = slots[slotOf[src]];
+    if (!(s.type & Fr_LONG)) {
+      Circom_SignalSlot &d = slots[slotOf[dst]];
+      d.shortVal = s.shortVal;
+      d.type = Fr_SHORT;
+    } else {
+      FrElement aux;
+      get(src, &aux);
+      set(dst, &aux);
+    }
+  }
+
+  // Copies the n signals of src from srcStart on to the signals from start
+  // on, skipping the ones that only have a scratch slot here. Threads can
+  // copy disjoint ranges at the same time.
+  void copyOwnSignals(u64 start, const Circom_SignalStore &src, u64 srcStart, u64 n);
+
+  void saveBlock(u64 start, uint n, Circom_SignalBlock &b) const;
+  void restoreBlock(u64 start, const Circom_SignalBlock &b);
+
+  // Bytes held by the store, headers, pool indexes and long value pool
+  u64 memoryUsage() const;
+
+  inline uint longValues() const {
+    return poolSize.load();
+  }
+};
+
+/*
+Builds the slot map of the circuit, once per circuit. Witness signal w gets
+slot w. A signal that is not in the witness is only read while the run of
+the father of its component is active (the inputs and outputs of a
+subcomponent are only accessed by the subcomponent and its father), so it
+gets a slot in the scratch frame of that father. The frames of the
+subcomponents of a component all start after the frame of the component,
+as the subcomponents run one after another. The scratch area is as deep
+as the deepest chain of frames.
+
+This relies on the component runs being nested, which is the case for the
+sequential code the circuit is generated with.
+*/
+void Circom_buildSignalLayout(Circom_Circuit *circuit);
+
 class Circom_CalcWit {
 
   bool *inputSignalAssigned;
@@ -23,7 +180,10 @@ class Circom_CalcWit {
 
 public:
 
-  FrElement *signalValues;
+  Circom_SignalStore signalValues;
+  // Compute the witness with run_native when the inputs allow it, cleared
+  // when the generic run had to be used
+  bool nativeEngine;
   Circom_Component* componentMemory;
   FrElement* circuitConstants; 
   std::map<u32,IODefPair> templateInsId2IOSignalInfo; 
@@ -36,6 +196,10 @@ public:
 
   uint maxThread;
 
+  // Memoization of the templates the size of their inputs and signals makes
+  // worth caching, on by default. See runComponent.
+  bool memoize;
+
   // Functions called by the circuit
   Circom_CalcWit(Circom_Circuit *aCircuit, uint numTh = NMUTEXES);
   ~Circom_CalcWit();
@@ -50,17 +214,32 @@ public:
   }
   
   inline void getWitness(uint idx, PFrElement val) {
-    Fr_copy(val, &signalValues[circuit->witness2SignalList[idx]]);
+    signalValues.getSlot(idx, val);
   }
 
   std::string getTrace(u64 id_cmp);
 
+  // Runs subcomponent cIdx once all its inputs are set. A component of a
+  // memoized template (see MEMO_MAX_INPUTS) whose template already ran with
+  // the same input values gets the signals of that run copied into place
+  // instead, the signal tables of the circuit give its inputs and its block.
+  void runComponent(uint cIdx);
+  std::string memoStats();
+
   std::string generate_position_array(uint* dimensions, uint size_dimensions, uint index);
 
 private:
   
   uint getInputSignalHashPosition(u64 h);
 
+  struct MemoCounts {
+    u64 hits;
+    u64 misses;
+  };
+  std::unordered_map<std::string, Circom_SignalBlock> memoBlocks;
+  std::map<std::string, MemoCounts> memoCounts;
+  bool memoKey(std::string &key, uint cIdx);
+
 };
 
 typedef void (*Circom_TemplateFunction)(uint __cIdx, Circom_CalcWit* __ctx); 
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+
+#include "verifier.hpp"
+
+/*
+Checks of the pairing and of the Groth16 verifier that need no files:
+
+  - e(a*P, b*Q) == e(a*b*P, Q) == e(P, Q)^(a*b), and e(P, Q) != 1,
+  - e(P, Q)^r == 1, the pairing lands in the subgroup of order r,
+  - a proof made with the trapdoor of a key, so known to be valid, passes
+    Groth16_verify and Groth16_verifyBatch,
+  - the same proof with A, B, C or a public input changed is rejected, on
+    its own and in a batch with valid proofs.
+
+Prints every check and exits with an error when one fails.
+
+    check_pairing
+*/
+
+// r, the order of G1, G2 and of the pairing values, the modulus of FrValue
+static const uint64_t R[4] = {0x43e1f593f0000001ULL, 0x2833e84879b97091ULL, 0xb85045b68181585dULL, 0x30644e72e131a029ULL};
+
+static bool ok = true;
+
+static void check(const char *name, bool passed) {
+  std::cout << (passed ? "ok     " : "FAILED ") << name << std::endl;
+  ok &= passed;
+}
+
+// A key whose alpha, beta, gamma, delta and IC are multiples of the
+// generators by known scalars, and proofs made from them: with
+// A = a*G1, B = b*G2 and C = (a*b - alpha*beta - l*gamma)/delta*G1,
+// where l = ic[0] + sum(public[j]*ic[j+1]), the verification equation
+// holds for any a and b.
+struct Trapdoor {
+  FrValue alpha, beta, gamma, delta;
+  std::vector<FrValue> ic;
+  Groth16_VerificationKey vk;
+
+  Trapdoor(uint32_t nPublic)
+    : alpha(FrValue::fromString("0x1d3f5c0b2a9e8d7c6b5a49382716f5e4d3c2b1a0")),
+      beta(FrValue::fromString("0x2e4c6a8f0b1d3e5f7a9c1e3b5d7f9a2c4e6b8d0f1")),
+      gamma(FrValue::fromString("0x3a5b7c9d1e2f4a6b8c0d2e4f6a8b0c1d3e5f7a9b2")),
+      delta(FrValue::fromString("0x4b6c8d0e2f3a5b7c9d1e3f5a7b9c1d2e4f6a8b0c3")) {
+    const G1Point g1 = G1_generator();
+    const G2Point g2 = G2_generator();
+    vk.nPublic = nPublic;
+    vk.alpha1 = g1.mul(alpha).toAffine();
+    vk.beta2 = g2.mul(beta).toAffine();
+    vk.gamma2 = g2.mul(gamma).toAffine();
+    vk.delta2 = g2.mul(delta).toAffine();
+    for (uint32_t i = 0; i <= nPublic; i++) {
+      ic.push_back(FrValue::fromInt(1000003*(i + 1) + 17));
+      vk.IC.push_back(g1.mul(ic[i]).toAffine());
+    }
+    G2Affine fixed[3] = {vk.beta2, vk.gamma2, vk.delta2};
+    pairing_prepare(fixed, 3, vk.prepared);
+  }
+
+  Groth16_Proof prove(const FrValue &a, const FrValue &b, const std::vector<FrValue> &publics) const {
+    FrValue l = ic[0];
+    for (uint32_t j = 0; j < vk.nPublic; j++) l = l + publics[j]*ic[j + 1];
+    const FrValue c = (a*b - alpha*beta - l*gamma)*delta.inv();
+    Groth16_Proof proof;
+    proof.a = G1_generator().mul(a).toAffine();
+    proof.b = G2_generator().mul(b).toAffine();
+    proof.c = G1_generator().mul(c).toAffine();
+    return proof;
+  }
+};
+
+static void checkPairing() {
+  const G1Point p = G1_generator();
+  const G2Point q = G2_generator();
+  const FrValue a = FrValue::fromString("0x2b8f1e4d7c0a3f6e9d2c5b8a1f4e7d0c3b6a9f2e5d8c1b4a7f0e3d6c9b2a5f8");
+  const FrValue b = FrValue::fromString("0x1c7e0d3f6a9c2e5b8d1f4a7c0e3b6d9f2a5c8e1b4d7f0a3c6e9b2d5f8a1c4e7");
+  const FrValue ab = a*b;
+
+  const Fq12Value e = pairing(p.toAffine(), q.toAffine());
+  const Fq12Value eab = pairing(p.mul(a).toAffine(), q.mul(b).toAffine());
+  FrValue abNormal = ab.toNormal();
+  check("e(P, Q) != 1", !e.isOne());
+  check("e(aP, bQ) == e(abP, Q)", eab == pairing(p.mul(ab).toAffine(), q.toAffine()));
+  check("e(aP, bQ) == e(P, abQ)", eab == pairing(p.toAffine(), q.mul(ab).toAffine()));
+  check("e(aP, bQ) == e(P, Q)^(ab)", eab == e.pow(abNormal.v, 4));
+  check("e(P, Q)^r == 1", e.pow(R, 4).isOne());
+  check("e(aP, bQ)^r == 1", eab.pow(R, 4).isOne());
+  check("e(aP, bQ)*e(-abP, Q) == 1, one final exponentiation", [&]() {
+    G1Affine ps[2] = {p.mul(a).toAffine(), (-p.mul(ab)).toAffine()};
+    G2Affine qs[2] = {q.mul(b).toAffine(), q.toAffine()};
+    G2Prepared prepared[2];
+    pairing_prepare(qs, 2, prepared);
+    return pairing_finalExp(pairing_millerLoop(ps, prepared, 2)).isOne();
+  }());
+}
+
+static void checkGroth16() {
+  const Trapdoor key(2);
+  std::vector<std::vector<FrValue>> publics = {
+    {FrValue::fromInt(1), FrValue::fromInt(2)},
+    {FrValue::fromString("0x123456789abcdef0123456789abcdef"), FrValue::fromInt(-5)},
+    {FrValue::fromInt(0), FrValue::fromInt(81)},
+  };
+  std::vector<Groth16_Proof> proofs;
+  for (uint64_t i = 0; i < publics.size(); i++) {
+    proofs.push_back(key.prove(FrValue::fromInt(7919*(i + 3)), FrValue::fromInt(104729*(i + 5)), publics[i]));
+  }
+
+  bool valid = true;
+  for (uint64_t i = 0; i < proofs.size(); i++) valid &= Groth16_verify(key.vk, proofs[i], publics[i]);
+  check("known proofs verify", valid);
+  check("known proofs verify as a batch", Groth16_verifyBatch(key.vk, &proofs[0], &publics[0], proofs.size(), 2));
+
+  const G1Point g1 = G1_generator();
+  const G2Point g2 = G2_generator();
+  std::vector<Groth16_Proof> tampered(4, proofs[1]);
+  std::vector<std::vector<FrValue>> tamperedPublics(4, publics[1]);
+  tampered[0].a = (G1Point(tampered[0].a) + g1).toAffine();
+  tampered[1].b = (G2Point(tampered[1].b) + g2).toAffine();
+  tampered[2].c = (G1Point(tampered[2].c) + g1).toAffine();
+  tamperedPublics[3][0] = tamperedPublics[3][0] + FrValue::one();
+  const char *names[4] = {"A + G1", "B + G2", "C + G1", "public[0] + 1"};
+
+  for (uint64_t t = 0; t < tampered.size(); t++) {
+    std::string name = std::string("proof with ") + names[t] + " is rejected";
+    check(name.c_str(), !Groth16_verify(key.vk, tampered[t], tamperedPublics[t]));
+
+    std::vector<Groth16_Proof> batch = proofs;
+    std::vector<std::vector<FrValue>> batchPublics = publics;
+    batch[1] = tampered[t];
+    batchPublics[1] = tamperedPublics[t];
+    std::vector<bool> results;
+    bool batchOk = Groth16_verifyBatch(key.vk, &batch[0], &batchPublics[0], batch.size(), 2, &results);
+    name = std::string("batch with ") + names[t] + " is rejected, only that proof";
+    check(name.c_str(), !batchOk && results[0] && !results[1] && results[2]);
+  }
+
+  check("proof with a missing public input is rejected", !Groth16_verify(key.vk, proofs[0], {publics[0][0]}));
+}
+
+int main() {
+  checkPairing();
+  checkGroth16();
+  if (!ok) {
+    std::cerr << "Pairing or Groth16 verifier check failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "OK" << std::endl;
+  return 0;
+}
@@ -37,6 +37,9 @@ struct Circom_Circuit {
   u64* witness2SignalList;
   FrElement* circuitConstants;  
   std::map<u32,IODefPair> templateInsId2IOSignalInfo;
+  // slot of each signal in the signal store, see Circom_buildSignalLayout
+  u32* signalSlots;
+  u64 slotNo;
 };
 
 
@@ -80,5 +83,21 @@ uint get_size_of_input_hashmap();
 uint get_size_of_witness();
 uint get_size_of_constants();
 uint get_size_of_io_map();
+uint get_main_template_id();
+
+// Signal layout of every template: its number of signals, and its
+// subcomponents as {template id, signal offset} pairs from
+// _templateSubcomponentStart[id] to _templateSubcomponentStart[id+1]
+extern const uint _templateSignalNo[];
+extern const uint _templateSubcomponentStart[];
+extern const uint _templateSubcomponents[][2];
+
+// Inputs of every template, _templateInputNo[id] signals from
+// _templateInputStart[id] on
+extern const uint _templateInputStart[];
+extern const uint _templateInputNo[];
+
+// Name of every template, to recognize the circuit
+extern const char *_templateNames[];
 
 #endif  // __CIRCOM_H
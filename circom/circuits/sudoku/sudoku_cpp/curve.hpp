@@ -0,0 +1,222 @@
+#ifndef __CURVE_H
+#define __CURVE_H
+
+#include <stdint.h>
+
+#include "fr.hpp"
+
+/*
+The BN254 (alt_bn128, snarkjs "bn128") curve: G1 over Fq and G2 over
+Fq2 = Fq[u]/(u^2 + 1), both y^2 = x^3 + b.
+
+Field elements are FieldElement values (see field.hpp), kept in Montgomery
+form with R = 2^256, which is the limb layout snarkjs writes points in
+(LEM). Affine points are stored as in the .zkey files, x then y, and the
+point at infinity is (0, 0), which is not on either curve.
+
+Points are computed in Jacobian coordinates, (X, Y, Z) is (X/Z^2, Y/Z^3)
+and Z = 0 is the point at infinity.
+*/
+
+typedef FieldElement<0x3c208c16d87cfd47ULL, 0x97816a916871ca8dULL, 0xb85045b68181585dULL, 0x30644e72e131a029ULL> FqValue;
+
+class Fq2Value {
+public:
+    FqValue c0;
+    FqValue c1;
+
+    constexpr Fq2Value() : c0(), c1() {}
+    constexpr Fq2Value(const FqValue &a0, const FqValue &a1) : c0(a0), c1(a1) {}
+
+    static constexpr Fq2Value zero() { return Fq2Value(); }
+    static constexpr Fq2Value one() { return Fq2Value(FqValue::one(), FqValue::zero()); }
+
+    constexpr bool isZero() const { return c0.isZero() && c1.isZero(); }
+    constexpr bool operator==(const Fq2Value &b) const { return c0 == b.c0 && c1 == b.c1; }
+    constexpr bool operator!=(const Fq2Value &b) const { return !(*this == b); }
+
+    constexpr Fq2Value operator+(const Fq2Value &b) const { return Fq2Value(c0 + b.c0, c1 + b.c1); }
+    constexpr Fq2Value operator-(const Fq2Value &b) const { return Fq2Value(c0 - b.c0, c1 - b.c1); }
+    constexpr Fq2Value operator-() const { return Fq2Value(-c0, -c1); }
+
+    // Karatsuba, 3 Fq multiplications
+    constexpr Fq2Value operator*(const Fq2Value &b) const {
+        FqValue a0b0 = c0*b.c0;
+        FqValue a1b1 = c1*b.c1;
+        return Fq2Value(a0b0 - a1b1, (c0 + c1)*(b.c0 + b.c1) - a0b0 - a1b1);
+    }
+
+    constexpr Fq2Value operator*(const FqValue &b) const { return Fq2Value(c0*b, c1*b); }
+
+    constexpr Fq2Value &operator+=(const Fq2Value &b) { *this = *this + b; return *this; }
+    constexpr Fq2Value &operator-=(const Fq2Value &b) { *this = *this - b; return *this; }
+    constexpr Fq2Value &operator*=(const Fq2Value &b) { *this = *this * b; return *this; }
+
+    constexpr Fq2Value square() const {
+        FqValue a01 = c0*c1;
+        return Fq2Value((c0 + c1)*(c0 - c1), a01 + a01);
+    }
+
+    constexpr Fq2Value dbl() const { return *this + *this; }
+
+    constexpr Fq2Value conjugate() const { return Fq2Value(c0, -c1); }
+
+    // The inverse of zero is zero
+    constexpr Fq2Value inv() const {
+        FqValue t = (c0.square() + c1.square()).inv();
+        return Fq2Value(c0*t, -(c1*t));
+    }
+};
+
+template <class F>
+struct CurveAffine {
+    F x;
+    F y;
+
+    constexpr bool isZero() const { return x.isZero() && y.isZero(); }
+};
+
+template <class F>
+class CurvePoint {
+public:
+    F x;
+    F y;
+    F z;
+
+    constexpr CurvePoint() : x(), y(), z() {}
+    constexpr CurvePoint(const F &ax, const F &ay, const F &az) : x(ax), y(ay), z(az) {}
+    constexpr CurvePoint(const CurveAffine<F> &a) : x(a.x), y(a.y), z(a.isZero() ? F::zero() : F::one()) {}
+
+    static constexpr CurvePoint zero() { return CurvePoint(); }
+
+    constexpr bool isZero() const { return z.isZero(); }
+
+    constexpr CurvePoint operator-() const { return CurvePoint(x, -y, z); }
+
+    // dbl-2009-l
+    constexpr CurvePoint dbl() const {
+        if (isZero()) return *this;
+        F a = x.square();
+        F b = y.square();
+        F c = b.square();
+        F d = ((x + b).square() - a - c).dbl();
+        F e = a.dbl() + a;
+        F f = e.square();
+        F x3 = f - d.dbl();
+        F c8 = c.dbl().dbl().dbl();
+        return CurvePoint(x3, e*(d - x3) - c8, (y*z).dbl());
+    }
+
+    // add-2007-bl
+    constexpr CurvePoint operator+(const CurvePoint &b) const {
+        if (isZero()) return b;
+        if (b.isZero()) return *this;
+        F z1z1 = z.square();
+        F z2z2 = b.z.square();
+        F u1 = x*z2z2;
+        F u2 = b.x*z1z1;
+        F s1 = y*b.z*z2z2;
+        F s2 = b.y*z*z1z1;
+        F h = u2 - u1;
+        F r = (s2 - s1).dbl();
+        if (h.isZero()) return r.isZero() ? dbl() : zero();
+        F i = h.dbl().square();
+        F j = h*i;
+        F v = u1*i;
+        F x3 = r.square() - j - v.dbl();
+        return CurvePoint(x3, r*(v - x3) - (s1*j).dbl(), ((z + b.z).square() - z1z1 - z2z2)*h);
+    }
+
+    // madd-2007-bl
+    constexpr CurvePoint operator+(const CurveAffine<F> &b) const {
+        if (b.isZero()) return *this;
+        if (isZero()) return CurvePoint(b);
+        F z1z1 = z.square();
+        F u2 = b.x*z1z1;
+        F s2 = b.y*z*z1z1;
+        F h = u2 - x;
+        F r = (s2 - y).dbl();
+        if (h.isZero()) return r.isZero() ? dbl() : zero();
+        F hh = h.square();
+        F i = hh.dbl().dbl();
+        F j = h*i;
+        F v = x*i;
+        F x3 = r.square() - j - v.dbl();
+        return CurvePoint(x3, r*(v - x3) - (y*j).dbl(), (z + h).square() - z1z1 - hh);
+    }
+
+    constexpr CurvePoint &operator+=(const CurvePoint &b) { *this = *this + b; return *this; }
+    constexpr CurvePoint &operator+=(const CurveAffine<F> &b) { *this = *this + b; return *this; }
+
+    constexpr CurvePoint operator-(const CurvePoint &b) const { return *this + (-b); }
+
+    // this * e, e given as Fr_N64 little endian limbs in normal form
+    constexpr CurvePoint mul(const uint64_t *e) const {
+        CurvePoint r;
+        for (int i = Fr_N64*64-1; i >= 0; i--) {
+            r = r.dbl();
+            if ((e[i >> 6] >> (i & 0x3F)) & 1) r += *this;
+        }
+        return r;
+    }
+
+    constexpr CurvePoint mul(const FrValue &e) const {
+        FrValue n = e.toNormal();
+        return mul(n.v);
+    }
+
+    constexpr CurveAffine<F> toAffine() const {
+        CurveAffine<F> a;
+        if (isZero()) return a;
+        F zInv = z.inv();
+        F zInv2 = zInv.square();
+        a.x = x*zInv2;
+        a.y = y*zInv2*zInv;
+        return a;
+    }
+
+    constexpr bool operator==(const CurvePoint &b) const {
+        if (isZero() || b.isZero()) return isZero() && b.isZero();
+        F z1z1 = z.square();
+        F z2z2 = b.z.square();
+        return x*z2z2 == b.x*z1z1 && y*z2z2*b.z == b.y*z1z1*z;
+    }
+
+    constexpr bool operator!=(const CurvePoint &b) const { return !(*this == b); }
+};
+
+typedef CurveAffine<FqValue> G1Affine;
+typedef CurveAffine<Fq2Value> G2Affine;
+typedef CurvePoint<FqValue> G1Point;
+typedef CurvePoint<Fq2Value> G2Point;
+
+// Generators, the ones of snarkjs and EIP-197
+inline G1Point G1_generator() {
+    return G1Point(FqValue(1), FqValue(2), FqValue::one());
+}
+
+inline G2Point G2_generator() {
+    return G2Point(
+        Fq2Value(FqValue::fromString("10857046999023057135944570762232829481370756359578518086990519993285655852781"),
+                 FqValue::fromString("11559732032986387107991004021392285783925812861821192530917403151452391805634")),
+        Fq2Value(FqValue::fromString("8495653923123431417604973247489272438418190587263600148770280649306958101930"),
+                 FqValue::fromString("4082367875863433681332203403145435568316851327593401208105741076214120093531")),
+        Fq2Value::one());
+}
+
+// y^2 == x^3 + 3, the point at infinity included
+inline bool G1_isOnCurve(const G1Affine &p) {
+    if (p.isZero()) return true;
+    return p.y.square() == p.x.square()*p.x + FqValue(3);
+}
+
+// y^2 == x^3 + 3/(9 + u), the point at infinity included
+inline bool G2_isOnCurve(const G2Affine &p) {
+    static const Fq2Value b(
+        FqValue::fromString("19485874751759354771024239261021720505790618469301721065564631296452457478373"),
+        FqValue::fromString("266929791119991161246907387137283842545076965332900288569378510910307636690"));
+    if (p.isZero()) return true;
+    return p.y.square() == p.x.square()*p.x + b;
+}
+
+#endif // __CURVE_H
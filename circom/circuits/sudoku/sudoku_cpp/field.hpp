@@ -0,0 +1,283 @@
+#ifndef __FIELD_H
+#define __FIELD_H
+
+#include <stdint.h>
+
+/*
+FieldElement is a value type for an element of the prime field with the
+4 limb modulus Q3:Q2:Q1:Q0 (Q < 2^255). It is kept in Montgomery form,
+fully reduced, so equal elements have equal limbs.
+
+Everything is constexpr: constants written as FieldElement::fromString("...")
+or FieldElement(n) are converted to Montgomery form at compile time, and the
+arithmetic is plain C++ the compiler can inline and keep in registers.
+*/
+
+template <uint64_t Q0, uint64_t Q1, uint64_t Q2, uint64_t Q3>
+struct FieldParams;
+
+template <uint64_t Q0, uint64_t Q1, uint64_t Q2, uint64_t Q3>
+class alignas(32) FieldElement {
+
+    typedef FieldParams<Q0, Q1, Q2, Q3> Params;
+
+public:
+    static const int N64 = 4;
+
+    uint64_t v[N64];
+
+    constexpr FieldElement() : v{0, 0, 0, 0} {}
+
+    constexpr explicit FieldElement(uint64_t a) : v{0, 0, 0, 0} {
+        FieldElement r = fromNormal(a, 0, 0, 0);
+        for (int i=0; i<N64; i++) v[i] = r.v[i];
+    }
+
+    // Builds an element from its normal (non Montgomery) limbs, a < 2^256
+    static constexpr FieldElement fromNormal(uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3) {
+        FieldElement r = fromMontgomery(a0, a1, a2, a3);
+        r.reduce();
+        return mul(r, Params::R2);
+    }
+
+    // Builds an element from limbs already in Montgomery form
+    static constexpr FieldElement fromMontgomery(uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3) {
+        FieldElement r;
+        r.v[0] = a0;
+        r.v[1] = a1;
+        r.v[2] = a2;
+        r.v[3] = a3;
+        return r;
+    }
+
+    static constexpr FieldElement fromInt(int64_t a) {
+        return a < 0 ? -FieldElement((uint64_t)0 - (uint64_t)a) : FieldElement((uint64_t)a);
+    }
+
+    // Parses a decimal or 0x prefixed hexadecimal number, reduced mod Q
+    static constexpr FieldElement fromString(const char *s) {
+        uint64_t radix = 10;
+        if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+            radix = 16;
+            s += 2;
+        }
+        // Accumulated in normal form, one extra limb holds r*radix + d < 16*Q + 16
+        uint64_t r[N64+1] = {0, 0, 0, 0, 0};
+        for (; *s; s++) {
+            uint64_t d = (*s >= '0' && *s <= '9') ? *s - '0'
+                       : (*s >= 'a' && *s <= 'f') ? *s - 'a' + 10
+                       : (*s >= 'A' && *s <= 'F') ? *s - 'A' + 10
+                       : 0;
+            unsigned __int128 c = d;
+            for (int i=0; i<=N64; i++) {
+                c += (unsigned __int128)r[i]*radix;
+                r[i] = (uint64_t)c;
+                c >>= 64;
+            }
+            while (r[N64] || !fromMontgomery(r[0], r[1], r[2], r[3]).lessThanQ()) {
+                uint64_t borrow = 0;
+                for (int i=0; i<=N64; i++) {
+                    unsigned __int128 t = (unsigned __int128)r[i] - (i < N64 ? q(i) : 0) - borrow;
+                    r[i] = (uint64_t)t;
+                    borrow = (uint64_t)(t >> 64) & 1;
+                }
+            }
+        }
+        return fromNormal(r[0], r[1], r[2], r[3]);
+    }
+
+    static constexpr FieldElement zero() { return FieldElement(); }
+    static constexpr FieldElement one() { return FieldElement((uint64_t)1); }
+
+    // Normal form limbs
+    constexpr FieldElement toNormal() const {
+        return mul(*this, fromMontgomery(1, 0, 0, 0));
+    }
+
+    constexpr bool isZero() const {
+        return !(v[0] | v[1] | v[2] | v[3]);
+    }
+
+    constexpr bool operator==(const FieldElement &b) const {
+        return v[0] == b.v[0] && v[1] == b.v[1] && v[2] == b.v[2] && v[3] == b.v[3];
+    }
+
+    constexpr bool operator!=(const FieldElement &b) const {
+        return !(*this == b);
+    }
+
+    constexpr FieldElement operator+(const FieldElement &b) const {
+        FieldElement r;
+        unsigned __int128 c = 0;
+        for (int i=0; i<N64; i++) {
+            c += (unsigned __int128)v[i] + b.v[i];
+            r.v[i] = (uint64_t)c;
+            c >>= 64;
+        }
+        r.reduce();
+        return r;
+    }
+
+    constexpr FieldElement operator-(const FieldElement &b) const {
+        FieldElement r;
+        uint64_t borrow = 0;
+        for (int i=0; i<N64; i++) {
+            unsigned __int128 d = (unsigned __int128)v[i] - b.v[i] - borrow;
+            r.v[i] = (uint64_t)d;
+            borrow = (uint64_t)(d >> 64) & 1;
+        }
+        if (borrow) r.addQ();
+        return r;
+    }
+
+    constexpr FieldElement operator-() const {
+        return FieldElement() - *this;
+    }
+
+    constexpr FieldElement operator*(const FieldElement &b) const {
+        return mul(*this, b);
+    }
+
+    constexpr FieldElement operator/(const FieldElement &b) const {
+        return mul(*this, b.inv());
+    }
+
+    constexpr FieldElement &operator+=(const FieldElement &b) { *this = *this + b; return *this; }
+    constexpr FieldElement &operator-=(const FieldElement &b) { *this = *this - b; return *this; }
+    constexpr FieldElement &operator*=(const FieldElement &b) { *this = *this * b; return *this; }
+
+    constexpr FieldElement square() const {
+        return mul(*this, *this);
+    }
+
+    constexpr FieldElement dbl() const {
+        return *this + *this;
+    }
+
+    // this^e, e given as N64 little endian limbs
+    constexpr FieldElement pow(const uint64_t *e) const {
+        FieldElement r = one();
+        for (int i=N64*64-1; i>=0; i--) {
+            r = r.square();
+            if ((e[i>>6] >> (i & 0x3F)) & 1) r = r * *this;
+        }
+        return r;
+    }
+
+    constexpr FieldElement pow(uint64_t e) const {
+        FieldElement r = one();
+        FieldElement b = *this;
+        while (e) {
+            if (e & 1) r = r * b;
+            e >>= 1;
+            if (e) b = b.square();
+        }
+        return r;
+    }
+
+    // Inverse by Fermat, the inverse of zero is zero
+    constexpr FieldElement inv() const {
+        uint64_t e[N64] = {Q0 - 2, Q1, Q2, Q3};
+        return pow(e);
+    }
+
+    static constexpr uint64_t q(int i) {
+        return i == 0 ? Q0 : i == 1 ? Q1 : i == 2 ? Q2 : Q3;
+    }
+
+    // -Q^-1 mod 2^64
+    static constexpr uint64_t computeNp() {
+        uint64_t inv = 1;
+        for (int i=0; i<6; i++) inv *= 2 - Q0*inv;
+        return (uint64_t)0 - inv;
+    }
+
+    // 2^512 mod Q, used to enter Montgomery form
+    static constexpr FieldElement computeR2() {
+        FieldElement r = fromMontgomery(1, 0, 0, 0);
+        for (int i=0; i<512; i++) {
+            uint64_t carry = r.v[N64-1] >> 63;
+            for (int j=N64-1; j>0; j--) r.v[j] = (r.v[j] << 1) | (r.v[j-1] >> 63);
+            r.v[0] <<= 1;
+            if (carry || !r.lessThanQ()) r.subQ();
+        }
+        return r;
+    }
+
+    static constexpr FieldElement mul(const FieldElement &a, const FieldElement &b) {
+        uint64_t t[N64+2] = {0, 0, 0, 0, 0, 0};
+        const uint64_t n = Params::NP;
+        for (int i=0; i<N64; i++) {
+            unsigned __int128 c = 0;
+            for (int j=0; j<N64; j++) {
+                c += (unsigned __int128)a.v[j]*b.v[i] + t[j];
+                t[j] = (uint64_t)c;
+                c >>= 64;
+            }
+            c += t[N64];
+            t[N64] = (uint64_t)c;
+            t[N64+1] = (uint64_t)(c >> 64);
+
+            uint64_t m = t[0]*n;
+            c = (unsigned __int128)m*Q0 + t[0];
+            c >>= 64;
+            for (int j=1; j<N64; j++) {
+                c += (unsigned __int128)m*q(j) + t[j];
+                t[j-1] = (uint64_t)c;
+                c >>= 64;
+            }
+            c += t[N64];
+            t[N64-1] = (uint64_t)c;
+            t[N64] = t[N64+1] + (uint64_t)(c >> 64);
+        }
+        FieldElement r = fromMontgomery(t[0], t[1], t[2], t[3]);
+        if (t[N64] || !r.lessThanQ()) r.subQ();
+        return r;
+    }
+
+private:
+
+    constexpr bool lessThanQ() const {
+        for (int i=N64-1; i>=0; i--) {
+            if (v[i] < q(i)) return true;
+            if (v[i] > q(i)) return false;
+        }
+        return false;
+    }
+
+    constexpr void subQ() {
+        uint64_t borrow = 0;
+        for (int i=0; i<N64; i++) {
+            unsigned __int128 d = (unsigned __int128)v[i] - q(i) - borrow;
+            v[i] = (uint64_t)d;
+            borrow = (uint64_t)(d >> 64) & 1;
+        }
+    }
+
+    constexpr void addQ() {
+        unsigned __int128 c = 0;
+        for (int i=0; i<N64; i++) {
+            c += (unsigned __int128)v[i] + q(i);
+            v[i] = (uint64_t)c;
+            c >>= 64;
+        }
+    }
+
+    constexpr void reduce() {
+        while (!lessThanQ()) subQ();
+    }
+};
+
+template <uint64_t Q0, uint64_t Q1, uint64_t Q2, uint64_t Q3>
+struct FieldParams {
+    static constexpr uint64_t NP = FieldElement<Q0, Q1, Q2, Q3>::computeNp();
+    static constexpr FieldElement<Q0, Q1, Q2, Q3> R2 = FieldElement<Q0, Q1, Q2, Q3>::computeR2();
+};
+
+template <uint64_t Q0, uint64_t Q1, uint64_t Q2, uint64_t Q3>
+constexpr uint64_t FieldParams<Q0, Q1, Q2, Q3>::NP;
+
+template <uint64_t Q0, uint64_t Q1, uint64_t Q2, uint64_t Q3>
+constexpr FieldElement<Q0, Q1, Q2, Q3> FieldParams<Q0, Q1, Q2, Q3>::R2;
+
+#endif // __FIELD_H
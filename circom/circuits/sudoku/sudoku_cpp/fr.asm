@@ -27,6 +27,12 @@
         global Fr_toMontgomery
         global Fr_toInt
         global Fr_isTrue
+        global Fr_addAsm
+        global Fr_subAsm
+        global Fr_eqAsm
+        global Fr_ltAsm
+        global Fr_toIntAsm
+        global Fr_isTrueAsm
         global Fr_q
         global Fr_R3
 
@@ -268,6 +274,7 @@ u64toLong_adjust_neg:
 ; Returs:
 ;   rax <= The value
 ;;;;;;;;;;;;;;;;;;;;;;;
+Fr_toIntAsm:
 Fr_toInt:
         mov     rax, [rdi]
         bt      rax, 63
@@ -1106,6 +1113,7 @@ toLongNormal_fromShort:
 ; Modified Registers:
 ;    r8, r9, 10, r11, rax, rcx
 ;;;;;;;;;;;;;;;;;;;;;;
+Fr_addAsm:
 Fr_add:
         push   rbp
         push   rsi
@@ -1603,6 +1611,7 @@ rawAddLS_done:
 ; Modified Registers:
 ;    r8, r9, 10, r11, rax, rcx
 ;;;;;;;;;;;;;;;;;;;;;;
+Fr_subAsm:
 Fr_sub:
         push   rbp
         push   rsi
@@ -8295,6 +8304,7 @@ Fr_gt:
 ; Modified Registers:
 ;    rax, rcx
 ;;;;;;;;;;;;;;;;;;;;;;
+Fr_ltAsm:
 Fr_lt:
         call Fr_rlt
         mov [rdi], rax
@@ -8311,6 +8321,7 @@ Fr_lt:
 ; Modified Registers:
 ;    rax, rcx
 ;;;;;;;;;;;;;;;;;;;;;;
+Fr_eqAsm:
 Fr_eq:
         call Fr_req
         mov [rdi], rax
@@ -8726,6 +8737,7 @@ lnot_retOne:
 ; Returs:
 ;   rax <= 1 if true 0 if false
 ;;;;;;;;;;;;;;;;;;;;;;;
+Fr_isTrueAsm:
 Fr_isTrue:
         
 
@@ -83,64 +83,128 @@ char *Fr_element2str(PFrElement pE) {
     return res;
 }
 
-void Fr_idiv(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma;
-    mpz_t mb;
-    mpz_t mr;
-    mpz_init(ma);
-    mpz_init(mb);
-    mpz_init(mr);
-
-    Fr_toMpz(ma, a);
-    // char *s1 = mpz_get_str (0, 10, ma);
-    // printf("s1 %s\n", s1);
-    Fr_toMpz(mb, b);
-    // char *s2 = mpz_get_str (0, 10, mb);
-    // printf("s2 %s\n", s2);
-    mpz_fdiv_q(mr, ma, mb);
-    // char *sr = mpz_get_str (0, 10, mr);
-    // printf("r %s\n", sr);
-    Fr_fromMpz(r, mr);
+// Stores a normalized raw value, keeping it short when it fits
+static void Fr_rawToElement(PFrElement r, FrRawElement v) {
+    if (!(v[1] | v[2] | v[3]) && v[0] < 0x80000000ULL) {
+        r->type = Fr_SHORT;
+        r->shortVal = (int32_t)v[0];
+    } else {
+        r->type = Fr_LONG;
+        for (int i=0; i<Fr_N64; i++) r->longVal[i] = v[i];
+    }
+}
 
-    mpz_clear(ma);
-    mpz_clear(mb);
-    mpz_clear(mr);
+static int Fr_rawLimbs(FrRawElement v) {
+    int n = Fr_N64;
+    while (n>0 && !v[n-1]) n--;
+    return n;
 }
 
-void Fr_mod(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma;
-    mpz_t mb;
-    mpz_t mr;
-    mpz_init(ma);
-    mpz_init(mb);
-    mpz_init(mr);
+// Integer division of the normalized representatives. Both results are
+// computed on the limbs with mpn, so no mpz temporaries are allocated.
+static void Fr_rawDivRem(FrRawElement rq, FrRawElement rr, PFrElement a, PFrElement b) {
+    FrElement tmp;
+    FrRawElement na;
+    FrRawElement nb;
+    Fr_toLongNormal(&tmp, a);
+    for (int i=0; i<Fr_N64; i++) na[i] = tmp.longVal[i];
+    Fr_toLongNormal(&tmp, b);
+    for (int i=0; i<Fr_N64; i++) nb[i] = tmp.longVal[i];
+    int an = Fr_rawLimbs(na);
+    int bn = Fr_rawLimbs(nb);
+    if (bn == 0) Fr_fail();
+    for (int i=0; i<Fr_N64; i++) {
+        rq[i] = 0;
+        rr[i] = 0;
+    }
+    if (an < bn) {
+        Fr_rawCopy(rr, na);
+        return;
+    }
+    mpn_tdiv_qr((mp_limb_t *)rq, (mp_limb_t *)rr, 0, (const mp_limb_t *)na, an, (const mp_limb_t *)nb, bn);
+}
 
-    Fr_toMpz(ma, a);
-    Fr_toMpz(mb, b);
-    mpz_fdiv_r(mr, ma, mb);
-    Fr_fromMpz(r, mr);
+void Fr_idiv(PFrElement r, PFrElement a, PFrElement b) {
+    if (!((a->type | b->type) & Fr_LONG) && a->shortVal >= 0 && b->shortVal > 0) {
+        r->type = Fr_SHORT;
+        r->shortVal = a->shortVal / b->shortVal;
+        return;
+    }
+    FrRawElement rq;
+    FrRawElement rr;
+    Fr_rawDivRem(rq, rr, a, b);
+    Fr_rawToElement(r, rq);
+}
 
-    mpz_clear(ma);
-    mpz_clear(mb);
-    mpz_clear(mr);
+void Fr_mod(PFrElement r, PFrElement a, PFrElement b) {
+    if (!((a->type | b->type) & Fr_LONG) && a->shortVal >= 0 && b->shortVal > 0) {
+        r->type = Fr_SHORT;
+        r->shortVal = a->shortVal % b->shortVal;
+        return;
+    }
+    FrRawElement rq;
+    FrRawElement rr;
+    Fr_rawDivRem(rq, rr, a, b);
+    Fr_rawToElement(r, rr);
 }
 
 void Fr_pow(PFrElement r, PFrElement a, PFrElement b) {
-    mpz_t ma;
-    mpz_t mb;
-    mpz_t mr;
-    mpz_init(ma);
-    mpz_init(mb);
-    mpz_init(mr);
+    if (!((a->type | b->type) & Fr_LONG) && a->shortVal >= 0 && b->shortVal >= 0) {
+        // Small powers such as 2**i stay in 64 bits while they fit
+        uint64_t base = a->shortVal;
+        uint64_t res = 1;
+        uint32_t e = b->shortVal;
+        while (e) {
+            if (e & 1) {
+                res *= base;
+                if (res >= 0x80000000ULL) break;
+            }
+            e >>= 1;
+            if (!e) break;
+            base *= base;
+            if (base >= 0x80000000ULL) break;
+        }
+        if (!e) {
+            r->type = Fr_SHORT;
+            r->shortVal = (int32_t)res;
+            return;
+        }
+    }
+    FrElement mBase;
+    FrElement nExp;
+    Fr_toMontgomery(&mBase, a);
+    Fr_toLongNormal(&nExp, b);
+    RawFr::Element base;
+    RawFr::Element res;
+    FrRawElement exp;
+    for (int i=0; i<Fr_N64; i++) {
+        base.v[i] = mBase.longVal[i];
+        exp[i] = nExp.longVal[i];
+    }
+    RawFr::field.exp(res, base, (uint8_t *)exp, Fr_N64*8);
+    r->type = Fr_LONGMONTGOMERY;
+    for (int i=0; i<Fr_N64; i++) r->longVal[i] = res.v[i];
+}
 
-    Fr_toMpz(ma, a);
-    Fr_toMpz(mb, b);
-    mpz_powm(mr, ma, mb, q);
-    Fr_fromMpz(r, mr);
+// Writes the nbits low bits of in as short 0/1 elements, the same values
+// (in >> i) & 1 gives, normalizing in only once
+void Fr_toBits(PFrElement out, PFrElement in, unsigned int nbits) {
+    FrElement tmp;
+    if (!(in->type & Fr_LONG) && in->shortVal >= 0) {
+        tmp.longVal[0] = in->shortVal;
+        for (int i=1; i<Fr_N64; i++) tmp.longVal[i] = 0;
+    } else {
+        Fr_toLongNormal(&tmp, in);
+    }
+    for (unsigned int i=0; i<nbits; i++) {
+        out[i].type = Fr_SHORT;
+        out[i].shortVal = (i < Fr_N64*64) ? (int32_t)((tmp.longVal[i>>6] >> (i & 0x3F)) & 1) : 0;
+    }
+}
 
-    mpz_clear(ma);
-    mpz_clear(mb);
-    mpz_clear(mr);
+void Fr_fromU64(PFrElement r, uint64_t v) {
+    FrRawElement raw = {v, 0, 0, 0};
+    Fr_rawToElement(r, raw);
 }
 
 void Fr_inv(PFrElement r, PFrElement a) {
@@ -172,9 +236,15 @@ RawFr::RawFr() {
     fromString(fZero, "0");
     fromString(fOne, "1");
     neg(fNegOne, fOne);
+
+    FrRawElement qMinus2;
+    Fr_rawCopy(qMinus2, Fr_rawq);
+    qMinus2[0] -= 2;
+    makeExpPlan(invPlan, (uint8_t *)qMinus2, Fr_N64*8);
 }
 
 RawFr::~RawFr() {
+    for (size_t i=0; i<fixedBases.size(); i++) delete fixedBases[i];
 }
 
 void RawFr::fromString(Element &r, std::string s) {
@@ -233,25 +303,168 @@ void RawFr::div(Element &r, Element &a, Element &b) {
 }
 
 #define BIT_IS_SET(s, p) (s[p>>3] & (1 << (p & 0x7)))
+#define NIBBLE(s, p) ((s[p>>1] >> ((p & 0x1)*4)) & 0xF)
+
+// Window width minimizing the odd powers table plus one multiplication per
+// window, about nBits/(w+1) windows for a random exponent
+static int expWindow(int nBits) {
+    int best = 1;
+    for (int w=2; w<=6; w++) {
+        if ((1 << (w-1)) + nBits/(w+1) < (1 << (best-1)) + nBits/(best+1)) best = w;
+    }
+    return best;
+}
+
+// table[k] = base^(2k+1) for k < 2^(w-1)
+static void expOddPowers(RawFr &F, RawFr::Element *table, RawFr::Element &base, int w) {
+    F.copy(table[0], base);
+    if (w == 1) return;
+    RawFr::Element base2;
+    F.square(base2, base);
+    for (int k=1; k < (1 << (w-1)); k++) F.mul(table[k], table[k-1], base2);
+}
+
+// Odd window ending at bit i: sets j to its lowest bit and returns its value
+static int expNextWindow(uint8_t* scalar, int i, int w, int &j) {
+    j = i-w+1 > 0 ? i-w+1 : 0;
+    while (!BIT_IS_SET(scalar, j)) j++;
+    int value = 0;
+    for (int k=i; k>=j; k--) value = (value << 1) | (BIT_IS_SET(scalar, k) ? 1 : 0);
+    return value;
+}
+
+static int expTrimBits(uint8_t* scalar, unsigned int scalarSize) {
+    int nBits = scalarSize*8;
+    while (nBits>0 && !BIT_IS_SET(scalar, (nBits-1))) nBits--;
+    return nBits;
+}
+
 void RawFr::exp(Element &r, Element &base, uint8_t* scalar, unsigned int scalarSize) {
-    bool oneFound = false;
-    Element copyBase;
-    copy(copyBase, base);
-    for (int i=scalarSize*8-1; i>=0; i--) {
-        if (!oneFound) {
-            if ( !BIT_IS_SET(scalar, i) ) continue;
-            copy(r, copyBase);
-            oneFound = true;
+    int nBits = expTrimBits(scalar, scalarSize);
+    if (nBits == 0) {
+        copy(r, fOne);
+        return;
+    }
+
+    Element res;
+    if (nBits <= 32) {
+        copy(res, base);
+        for (int i=nBits-2; i>=0; i--) {
+            square(res, res);
+            if ( BIT_IS_SET(scalar, i) ) {
+                mul(res, res, base);
+            }
+        }
+        copy(r, res);
+        return;
+    }
+
+    // Sliding window over the odd powers, the top bit is set so the first
+    // window initializes res
+    int w = expWindow(nBits);
+    Element table[32];
+    expOddPowers(*this, table, base, w);
+
+    int i = nBits-1;
+    int j;
+    copy(res, table[expNextWindow(scalar, i, w, j) >> 1]);
+    i = j-1;
+    while (i >= 0) {
+        if (!BIT_IS_SET(scalar, i)) {
+            square(res, res);
+            i--;
             continue;
         }
-        square(r, r);
-        if ( BIT_IS_SET(scalar, i) ) {
-            mul(r, r, copyBase);
+        int value = expNextWindow(scalar, i, w, j);
+        for (int k=j; k<=i; k++) square(res, res);
+        mul(res, res, table[value >> 1]);
+        i = j-1;
+    }
+    copy(r, res);
+}
+
+void RawFr::makeExpPlan(ExpPlan &plan, uint8_t* scalar, unsigned int scalarSize) {
+    int nBits = expTrimBits(scalar, scalarSize);
+    plan.window = expWindow(nBits);
+    plan.steps.clear();
+    plan.trailingSquarings = 0;
+
+    int i = nBits-1;
+    unsigned int squarings = 0;
+    while (i >= 0) {
+        if (!BIT_IS_SET(scalar, i)) {
+            squarings++;
+            i--;
+            continue;
         }
+        int j;
+        int value = expNextWindow(scalar, i, plan.window, j);
+        squarings += i-j+1;
+        ExpPlan::Step step;
+        step.squarings = plan.steps.empty() ? 0 : squarings;
+        step.index = value >> 1;
+        plan.steps.push_back(step);
+        squarings = 0;
+        i = j-1;
     }
-    if (!oneFound) {
+    plan.trailingSquarings = squarings;
+}
+
+void RawFr::exp(Element &r, Element &base, const ExpPlan &plan) {
+    if (plan.steps.empty()) {
         copy(r, fOne);
+        return;
+    }
+    Element table[32];
+    expOddPowers(*this, table, base, plan.window);
+
+    Element res;
+    copy(res, table[plan.steps[0].index]);
+    for (size_t s=1; s<plan.steps.size(); s++) {
+        for (unsigned int k=0; k<plan.steps[s].squarings; k++) square(res, res);
+        mul(res, res, table[plan.steps[s].index]);
+    }
+    for (unsigned int k=0; k<plan.trailingSquarings; k++) square(res, res);
+    copy(r, res);
+}
+
+void RawFr::invExp(Element &r, Element &a) {
+    exp(r, a, invPlan);
+}
+
+RawFr::FixedBase *RawFr::registerFixedBase(Element &base) {
+    std::lock_guard<std::mutex> lock(fixedBasesMutex);
+    for (size_t i=0; i<fixedBases.size(); i++) {
+        if (eq(fixedBases[i]->base, base)) return fixedBases[i];
+    }
+    FixedBase *fb = new FixedBase;
+    copy(fb->base, base);
+    Element p;
+    copy(p, base);
+    for (int i=0; i<FixedBaseWindows; i++) {
+        copy(fb->table[i][0], p);
+        for (int j=1; j<15; j++) mul(fb->table[i][j], fb->table[i][j-1], p);
+        mul(p, fb->table[i][14], p);
+    }
+    fixedBases.push_back(fb);
+    return fb;
+}
+
+void RawFr::exp(Element &r, FixedBase *fb, uint8_t* scalar, unsigned int scalarSize) {
+    int nNibbles = scalarSize*2;
+    while (nNibbles>0 && !NIBBLE(scalar, (nNibbles-1))) nNibbles--;
+    if (nNibbles > FixedBaseWindows) {
+        exp(r, fb->base, scalar, scalarSize);
+        return;
+    }
+
+    Element res;
+    copy(res, fOne);
+    for (int i=0; i<nNibbles; i++) {
+        int w = NIBBLE(scalar, i);
+        if (w) mul(res, res, fb->table[i][w-1]);
     }
+    copy(r, res);
 }
 
 void RawFr::toMpz(mpz_t r, Element &a) {
@@ -3,10 +3,14 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
+#include <mutex>
 #include <gmp.h>
+#include "field.hpp"
 
 #define Fr_N64 4
 #define Fr_SHORT 0x00000000
+#define Fr_SHORTMONTGOMERY 0x40000000
 #define Fr_LONG 0x80000000
 #define Fr_LONGMONTGOMERY 0xC0000000
 typedef uint64_t FrRawElement[Fr_N64];
@@ -16,15 +20,17 @@ typedef struct __attribute__((__packed__)) {
     FrRawElement longVal;
 } FrElement;
 typedef FrElement *PFrElement;
+
+// Unpacked value type of the same field, see field.hpp
+typedef FieldElement<0x43e1f593f0000001ULL, 0x2833e84879b97091ULL, 0xb85045b68181585dULL, 0x30644e72e131a029ULL> FrValue;
 extern FrElement Fr_q;
 extern FrElement Fr_R3;
 extern FrRawElement Fr_rawq;
 extern FrRawElement Fr_rawR3;
 
-extern "C" void Fr_copy(PFrElement r, PFrElement a);
 extern "C" void Fr_copyn(PFrElement r, PFrElement a, int n);
-extern "C" void Fr_add(PFrElement r, PFrElement a, PFrElement b);
-extern "C" void Fr_sub(PFrElement r, PFrElement a, PFrElement b);
+extern "C" void Fr_addAsm(PFrElement r, PFrElement a, PFrElement b);
+extern "C" void Fr_subAsm(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_neg(PFrElement r, PFrElement a);
 extern "C" void Fr_mul(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_square(PFrElement r, PFrElement a);
@@ -34,9 +40,9 @@ extern "C" void Fr_bxor(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_bnot(PFrElement r, PFrElement a);
 extern "C" void Fr_shl(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_shr(PFrElement r, PFrElement a, PFrElement b);
-extern "C" void Fr_eq(PFrElement r, PFrElement a, PFrElement b);
+extern "C" void Fr_eqAsm(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_neq(PFrElement r, PFrElement a, PFrElement b);
-extern "C" void Fr_lt(PFrElement r, PFrElement a, PFrElement b);
+extern "C" void Fr_ltAsm(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_gt(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_leq(PFrElement r, PFrElement a, PFrElement b);
 extern "C" void Fr_geq(PFrElement r, PFrElement a, PFrElement b);
@@ -47,8 +53,8 @@ extern "C" void Fr_toNormal(PFrElement r, PFrElement a);
 extern "C" void Fr_toLongNormal(PFrElement r, PFrElement a);
 extern "C" void Fr_toMontgomery(PFrElement r, PFrElement a);
 
-extern "C" int Fr_isTrue(PFrElement pE);
-extern "C" int Fr_toInt(PFrElement pE);
+extern "C" int Fr_isTrueAsm(PFrElement pE);
+extern "C" int Fr_toIntAsm(PFrElement pE);
 
 extern "C" void Fr_rawCopy(FrRawElement pRawResult, FrRawElement pRawA);
 extern "C" void Fr_rawSwap(FrRawElement pRawResult, FrRawElement pRawA);
@@ -65,6 +71,82 @@ extern "C" int Fr_rawIsZero(FrRawElement pRawB);
 
 extern "C" void Fr_fail();
 
+// Inline fast paths for short operands. Long and Montgomery operands, and
+// short results that overflow 32 bits, fall through to the asm.
+
+inline void Fr_copy(PFrElement r, PFrElement a) {
+    *r = *a;
+}
+
+inline void Fr_add(PFrElement r, PFrElement a, PFrElement b) {
+    if (!((a->type | b->type) & Fr_LONG)) {
+        int64_t res = (int64_t)a->shortVal + (int64_t)b->shortVal;
+        if (res == (int32_t)res) {
+            r->type = Fr_SHORT;
+            r->shortVal = (int32_t)res;
+            return;
+        }
+    }
+    Fr_addAsm(r, a, b);
+}
+
+inline void Fr_sub(PFrElement r, PFrElement a, PFrElement b) {
+    if (!((a->type | b->type) & Fr_LONG)) {
+        int64_t res = (int64_t)a->shortVal - (int64_t)b->shortVal;
+        if (res == (int32_t)res) {
+            r->type = Fr_SHORT;
+            r->shortVal = (int32_t)res;
+            return;
+        }
+    }
+    Fr_subAsm(r, a, b);
+}
+
+inline void Fr_eq(PFrElement r, PFrElement a, PFrElement b) {
+    if (!((a->type | b->type) & Fr_LONG)) {
+        int32_t res = a->shortVal == b->shortVal;
+        r->type = Fr_SHORT;
+        r->shortVal = res;
+        return;
+    }
+    Fr_eqAsm(r, a, b);
+}
+
+inline void Fr_lt(PFrElement r, PFrElement a, PFrElement b) {
+    if (!((a->type | b->type) & Fr_LONG)) {
+        int32_t res = a->shortVal < b->shortVal;
+        r->type = Fr_SHORT;
+        r->shortVal = res;
+        return;
+    }
+    Fr_ltAsm(r, a, b);
+}
+
+inline int Fr_isTrue(PFrElement pE) {
+    if (!(pE->type & Fr_LONG)) return pE->shortVal != 0;
+    return Fr_isTrueAsm(pE);
+}
+
+inline int Fr_toInt(PFrElement pE) {
+    if (!(pE->type & Fr_LONG)) return pE->shortVal;
+    return Fr_toIntAsm(pE);
+}
+
+
+inline void Fr_toValue(FrValue &r, PFrElement a) {
+    if (a->type & Fr_SHORTMONTGOMERY) {
+        r = FrValue::fromMontgomery(a->longVal[0], a->longVal[1], a->longVal[2], a->longVal[3]);
+    } else if (a->type & Fr_LONG) {
+        r = FrValue::fromNormal(a->longVal[0], a->longVal[1], a->longVal[2], a->longVal[3]);
+    } else {
+        r = FrValue::fromInt(a->shortVal);
+    }
+}
+
+inline void Fr_fromValue(PFrElement r, const FrValue &a) {
+    r->type = Fr_LONGMONTGOMERY;
+    for (int i=0; i<Fr_N64; i++) r->longVal[i] = a.v[i];
+}
 
 // Pending functions to convert
 
@@ -75,6 +157,8 @@ void Fr_mod(PFrElement r, PFrElement a, PFrElement b);
 void Fr_inv(PFrElement r, PFrElement a);
 void Fr_div(PFrElement r, PFrElement a, PFrElement b);
 void Fr_pow(PFrElement r, PFrElement a, PFrElement b);
+void Fr_toBits(PFrElement out, PFrElement in, unsigned int nbits);
+void Fr_fromU64(PFrElement r, uint64_t v);
 
 class RawFr {
 
@@ -87,11 +171,38 @@ public:
         FrRawElement v;
     };
 
+    // Sliding window recoding of a constant exponent: every step squares
+    // squarings times and then multiplies by the odd power 2*index+1 of the
+    // base. Building it once lets exponents like q-2 skip the bit scanning
+    // and the window choice on every call.
+    struct ExpPlan {
+        struct Step {
+            uint16_t squarings;
+            uint16_t index;
+        };
+        int window;
+        std::vector<Step> steps;
+        unsigned int trailingSquarings;
+    };
+
+    // Powers base^(j*16^i) for every nibble position i of a MaxBits scalar,
+    // an exponentiation is then one multiplication per non zero nibble
+    const static int FixedBaseWindows = (MaxBits+3)/4;
+    struct FixedBase {
+        Element base;
+        Element table[FixedBaseWindows][15];
+    };
+
 private:
     Element fZero;
     Element fOne;
     Element fNegOne;
 
+    ExpPlan invPlan;
+
+    std::mutex fixedBasesMutex;
+    std::vector<FixedBase *> fixedBases;
+
 public:
 
     RawFr();
@@ -116,11 +227,25 @@ public:
     void div(Element &r, Element &a, Element &b);
     void exp(Element &r, Element &base, uint8_t* scalar, unsigned int scalarSize);
 
+    void makeExpPlan(ExpPlan &plan, uint8_t* scalar, unsigned int scalarSize);
+    void exp(Element &r, Element &base, const ExpPlan &plan);
+    // a^(q-2) with a cached plan, the inverse of zero is zero
+    void invExp(Element &r, Element &a);
+
+    // The table of a base is computed on the first registration and kept
+    // until the process ends, so it is shared by every thread and caller
+    FixedBase *registerFixedBase(Element &base);
+    void exp(Element &r, FixedBase *fb, uint8_t* scalar, unsigned int scalarSize);
+
     void inline toMontgomery(Element &r, Element &a) { Fr_rawToMontgomery(r.v, a.v); };
     void inline fromMontgomery(Element &r, Element &a) { Fr_rawFromMontgomery(r.v, a.v); };
     int inline eq(Element &a, Element &b) { return Fr_rawIsEq(a.v, b.v); };
     int inline isZero(Element &a) { return Fr_rawIsZero(a.v); };
 
+    // Element and FrValue share the Montgomery limb layout
+    void inline fromValue(Element &r, const FrValue &a) { for (int i=0; i<N64; i++) r.v[i] = a.v[i]; };
+    FrValue inline toValue(Element &a) { return FrValue::fromMontgomery(a.v[0], a.v[1], a.v[2], a.v[3]); };
+
     void toMpz(mpz_t r, Element &a);
     void fromMpz(Element &a, mpz_t r);
 
@@ -0,0 +1,184 @@
+#include <gmp.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "groth16.hpp"
+#include "msm.hpp"
+#include "ntt.hpp"
+
+static RawFr &F = RawFr::field;
+
+static unsigned log2u(uint64_t n) {
+    unsigned bits = 0;
+    while (((uint64_t)1 << bits) < n) bits++;
+    return bits;
+}
+
+// The evaluations on the domain of size 2^bits to the evaluations on the
+// odd coset shift*w^i of the domain of size 2^(bits+1)
+static void toOddCoset(RawFr::Element *a, unsigned bits, unsigned nThreads) {
+    const Ntt &ntt = Ntt::get(bits);
+    ntt.ifft(a, nThreads);
+    ntt.shift(a, Ntt::root(bits + 1), nThreads);
+    ntt.fft(a, nThreads);
+}
+
+static double elapsed(std::chrono::high_resolution_clock::time_point &start) {
+    auto now = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - start).count();
+    start = now;
+    return ms;
+}
+
+void Groth16_prove(const Groth16_ZKey &zkey, const uint64_t *witness, const FrValue &r, const FrValue &s,
+                   Groth16_Proof &proof, unsigned nThreads, Groth16_Timings *timings) {
+    auto t_start = std::chrono::high_resolution_clock::now();
+    if (nThreads == 0) nThreads = 1;
+    const uint64_t n = zkey.domainSize;
+    const unsigned bits = log2u(n);
+    if (bits >= NTT_MAX_BITS) throw std::runtime_error("domain too large for bn128");
+
+    // A and B of every constraint, C = A*B
+    std::vector<RawFr::Element> abc[3];
+    for (auto &v : abc) v.assign(n, F.zero());
+    RawFr::Element t, w, coef;
+    for (auto &c : zkey.coefs) {
+        for (int k = 0; k < Fr_N64; k++) {
+            w.v[k] = witness[(uint64_t)c.signal*Fr_N64 + k];
+            coef.v[k] = c.value[k];
+        }
+        F.mul(t, coef, w);
+        F.add(abc[c.matrix][c.constraint], abc[c.matrix][c.constraint], t);
+    }
+    for (uint64_t i = 0; i < n; i++) F.mul(abc[2][i], abc[0][i], abc[1][i]);
+    double t_abc = elapsed(t_start);
+
+    // A, B and C on the odd coset, side by side with a third of the threads
+    // each when there are enough
+    if (nThreads >= 3) {
+        std::vector<std::thread> threads;
+        for (auto &v : abc) threads.push_back(std::thread(toOddCoset, &v[0], bits, nThreads/3));
+        for (auto &th : threads) th.join();
+    } else {
+        for (auto &v : abc) toOddCoset(&v[0], bits, nThreads);
+    }
+
+    // h = A*B - C, normal form for the multi scalar multiplication
+    std::vector<uint64_t> h(n*Fr_N64);
+    for (uint64_t i = 0; i < n; i++) {
+        F.mul(t, abc[0][i], abc[1][i]);
+        F.sub(t, t, abc[2][i]);
+        F.fromMontgomery(t, t);
+        for (int k = 0; k < Fr_N64; k++) h[i*Fr_N64 + k] = t.v[k];
+    }
+    double t_fft = elapsed(t_start);
+
+    const uint64_t nPrivate = zkey.nVars - zkey.nPublic - 1;
+    G1Point a = msm(zkey.A.data(), witness, zkey.nVars, nThreads);
+    G1Point b1 = msm(zkey.B1.data(), witness, zkey.nVars, nThreads);
+    G2Point b2 = msm(zkey.B2.data(), witness, zkey.nVars, nThreads);
+    G1Point c = msm(zkey.C.data(), &witness[(zkey.nPublic + 1)*Fr_N64], nPrivate, nThreads);
+    c += msm(zkey.H.data(), &h[0], n, nThreads);
+
+    // pi_a = A + alpha + r*delta, pi_b = B + beta + s*delta,
+    // pi_c = C + H + s*pi_a + r*(B1 + beta1 + s*delta1) - r*s*delta1
+    G1Point delta1(zkey.delta1);
+    a += zkey.alpha1;
+    a += delta1.mul(r);
+    b1 += zkey.beta1;
+    b1 += delta1.mul(s);
+    b2 += zkey.beta2;
+    b2 += G2Point(zkey.delta2).mul(s);
+    c += a.mul(s);
+    c += b1.mul(r);
+    c = c - delta1.mul(r*s);
+
+    proof.a = a.toAffine();
+    proof.b = b2.toAffine();
+    proof.c = c.toAffine();
+    double t_msm = elapsed(t_start);
+
+    if (timings) {
+        timings->abc = t_abc;
+        timings->fft = t_fft;
+        timings->msm = t_msm;
+    }
+}
+
+FrValue Groth16_randomFr() {
+    std::random_device rd;
+    std::uniform_int_distribution<uint64_t> dist;
+    while (true) {
+        uint64_t v[Fr_N64];
+        for (int k = 0; k < Fr_N64; k++) v[k] = dist(rd);
+        v[Fr_N64-1] &= 0x3FFFFFFFFFFFFFFFULL;
+        // rejection keeps the distribution uniform below r
+        int k = Fr_N64 - 1;
+        while (k > 0 && v[k] == Fr_q.longVal[k]) k--;
+        if (v[k] >= Fr_q.longVal[k]) continue;
+        FrValue x = FrValue::fromNormal(v[0], v[1], v[2], v[3]);
+        if (!x.isZero()) return x;
+    }
+}
+
+void Groth16_prove(const Groth16_ZKey &zkey, const uint64_t *witness,
+                   Groth16_Proof &proof, unsigned nThreads, Groth16_Timings *timings) {
+    Groth16_prove(zkey, witness, Groth16_randomFr(), Groth16_randomFr(), proof, nThreads, timings);
+}
+
+static std::string toDecimal(const uint64_t *limbs) {
+    mpz_t z;
+    mpz_init(z);
+    mpz_import(z, Fr_N64, -1, 8, 0, 0, limbs);
+    char *str = mpz_get_str(0, 10, z);
+    std::string s(str);
+    void (*freefunc)(void *, size_t);
+    mp_get_memory_functions(NULL, NULL, &freefunc);
+    freefunc(str, strlen(str) + 1);
+    mpz_clear(z);
+    return s;
+}
+
+static std::string toDecimal(const FqValue &a) {
+    return toDecimal(a.toNormal().v);
+}
+
+// The layout of JSON.stringify(value, null, 1)
+std::string Groth16_proofJson(const Groth16_Proof &proof) {
+    std::ostringstream out;
+    out << "{\n";
+    out << " \"pi_a\": [\n";
+    out << "  \"" << toDecimal(proof.a.x) << "\",\n";
+    out << "  \"" << toDecimal(proof.a.y) << "\",\n";
+    out << "  \"1\"\n";
+    out << " ],\n";
+    out << " \"pi_b\": [\n";
+    out << "  [\n   \"" << toDecimal(proof.b.x.c0) << "\",\n   \"" << toDecimal(proof.b.x.c1) << "\"\n  ],\n";
+    out << "  [\n   \"" << toDecimal(proof.b.y.c0) << "\",\n   \"" << toDecimal(proof.b.y.c1) << "\"\n  ],\n";
+    out << "  [\n   \"1\",\n   \"0\"\n  ]\n";
+    out << " ],\n";
+    out << " \"pi_c\": [\n";
+    out << "  \"" << toDecimal(proof.c.x) << "\",\n";
+    out << "  \"" << toDecimal(proof.c.y) << "\",\n";
+    out << "  \"1\"\n";
+    out << " ],\n";
+    out << " \"protocol\": \"groth16\",\n";
+    out << " \"curve\": \"bn128\"\n";
+    out << "}";
+    return out.str();
+}
+
+std::string Groth16_publicJson(const Groth16_ZKey &zkey, const uint64_t *witness) {
+    std::ostringstream out;
+    out << "[";
+    for (uint32_t i = 1; i <= zkey.nPublic; i++) {
+        out << (i > 1 ? ",\n " : "\n ") << "\"" << toDecimal(&witness[(uint64_t)i*Fr_N64]) << "\"";
+    }
+    out << "\n]";
+    return out.str();
+}
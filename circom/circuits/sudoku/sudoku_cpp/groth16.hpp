@@ -0,0 +1,53 @@
+#ifndef __GROTH16_H
+#define __GROTH16_H
+
+#include <string>
+
+#include "zkey.hpp"
+
+/*
+Native Groth16 prover for snarkjs proving keys, the same computation as
+"snarkjs groth16 prove":
+
+- the A and B evaluations of every constraint from the coefficients of the
+  key and the witness, and C = A*B
+- the three of them are interpolated (inverse FFT), moved to the odd coset
+  of the domain of size 2*domainSize and evaluated there (FFT), and
+  h = A*B - C on the coset is the quotient the H points of the key expect
+- the multi scalar multiplications of the A, B and C points of the key by
+  the witness and of the H points by h, blinded with r and s
+
+The witness is in normal form, Fr_N64 limbs per value, the layout of the
+.wtns files. The proof verifies with "snarkjs groth16 verify".
+*/
+
+struct Groth16_Proof {
+    G1Affine a;
+    G2Affine b;
+    G1Affine c;
+};
+
+// Milliseconds spent in every phase of one proof
+struct Groth16_Timings {
+    double abc;    // A, B and C evaluations
+    double fft;    // inverse FFT, coset shift, FFT and h
+    double msm;    // multi scalar multiplications and blinding
+};
+
+// Proof with the blinding factors r and s. nThreads splits the FFTs and the
+// multi scalar multiplications.
+void Groth16_prove(const Groth16_ZKey &zkey, const uint64_t *witness, const FrValue &r, const FrValue &s,
+                   Groth16_Proof &proof, unsigned nThreads = 1, Groth16_Timings *timings = nullptr);
+
+// Proof with random blinding factors
+void Groth16_prove(const Groth16_ZKey &zkey, const uint64_t *witness,
+                   Groth16_Proof &proof, unsigned nThreads = 1, Groth16_Timings *timings = nullptr);
+
+// A uniformly random non zero element of Fr from std::random_device
+FrValue Groth16_randomFr();
+
+// proof.json and public.json as snarkjs writes them
+std::string Groth16_proofJson(const Groth16_Proof &proof);
+std::string Groth16_publicJson(const Groth16_ZKey &zkey, const uint64_t *witness);
+
+#endif // __GROTH16_H
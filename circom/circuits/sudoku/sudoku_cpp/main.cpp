@@ -14,6 +14,8 @@ using json = nlohmann::json;
 
 #include "calcwit.hpp"
 #include "circom.hpp"
+#include "sudoku_native.hpp"
+#include "groth16.hpp"
 
 
 #define handle_error(msg) \
@@ -91,6 +93,8 @@ Circom_Circuit* loadCircuit(std::string const &datFileName) {
     circuit->templateInsId2IOSignalInfo = move(templateInsId2IOSignalInfo1);
     
     munmap(bdata, sb.st_size);
+
+    Circom_buildSignalLayout(circuit);
     
     return circuit;
 }
@@ -119,42 +123,105 @@ void json2FrElements (json val, std::vector<FrElement> & vval){
 }
 
 
-void loadJson(Circom_CalcWit *ctx, std::string filename) {
+struct InputSignal {
+  std::string name;
+  std::vector<FrElement> values;
+};
+
+/*
+Packed public inputs, see PackedSudoku in sudoku_templates.circom. A circuit
+with a packed input and no unsolved input also takes the unsolved board,
+which is packed here as sudoku_pack_board does.
+*/
+bool circuitHasInput(Circom_Circuit *circuit, std::string name, u64 &size) {
+  u64 h = fnv1a(name);
+  for (uint i = 0; i < get_size_of_input_hashmap(); i++) {
+    if (circuit->InputHashMap[i].hash == h) {
+      size = circuit->InputHashMap[i].signalsize;
+      return true;
+    }
+  }
+  return false;
+}
+
+void packInputs(Circom_Circuit *circuit, std::vector<InputSignal> &inputs) {
+  u64 packedSize, unsolvedSize;
+  if (!circuitHasInput(circuit, "packed", packedSize) || circuitHasInput(circuit, "unsolved", unsolvedSize)) return;
+  for (uint k = 0; k < inputs.size(); k++) {
+    if (inputs[k].name != "unsolved") continue;
+
+    std::vector<FrElement> &values = inputs[k].values;
+    uint n = 1;
+    while (n*n < values.size()) n++;
+    if (n*n != values.size() || sudoku_packed_size(n) != packedSize) {
+      throw std::runtime_error("Error packing signal unsolved: the board does not fit the packed input\n");
+    }
+    std::vector<int> cells(values.size());
+    for (uint c = 0; c < values.size(); c++) {
+      if ((values[c].type & Fr_LONG) || values[c].shortVal < 0 || values[c].shortVal >= (1 << sudoku_pack_bits(n))) {
+        throw std::runtime_error("Error packing signal unsolved: cell out of range\n");
+      }
+      cells[c] = values[c].shortVal;
+    }
+
+    std::vector<FrValue> packed(packedSize);
+    sudoku_pack_board(n, &cells[0], &packed[0]);
+    inputs[k].name = "packed";
+    inputs[k].values.resize(packedSize);
+    for (uint e = 0; e < packedSize; e++) Fr_fromValue(&inputs[k].values[e], packed[e]);
+  }
+}
+
+std::vector<InputSignal> readJsonInputs(Circom_Circuit *circuit, std::string filename) {
   std::ifstream inStream(filename);
   json j;
   inStream >> j;
-  
-  u64 nItems = j.size();
-  // printf("Items : %llu\n",nItems);
+
+  std::vector<InputSignal> inputs;
   for (json::iterator it = j.begin(); it != j.end(); ++it) {
     // std::cout << it.key() << " => " << it.value() << '\n';
-    u64 h = fnv1a(it.key());
-    std::vector<FrElement> v;
-    json2FrElements(it.value(),v);
+    InputSignal in;
+    in.name = it.key();
+    json2FrElements(it.value(),in.values);
+    inputs.push_back(in);
+  }
+  packInputs(circuit, inputs);
+  return inputs;
+}
+
+void setInputs(Circom_CalcWit *ctx, std::vector<InputSignal> &inputs) {
+  for (uint k = 0; k < inputs.size(); k++) {
+    std::vector<FrElement> &v = inputs[k].values;
+    u64 h = fnv1a(inputs[k].name);
     uint signalSize = ctx->getInputSignalSize(h);
     if (v.size() < signalSize) {
 	std::ostringstream errStrStream;
-	errStrStream << "Error loading signal " << it.key() << ": Not enough values\n";
+	errStrStream << "Error loading signal " << inputs[k].name << ": Not enough values\n";
 	throw std::runtime_error(errStrStream.str() );
     }
     if (v.size() > signalSize) {
 	std::ostringstream errStrStream;
-	errStrStream << "Error loading signal " << it.key() << ": Too many values\n";
+	errStrStream << "Error loading signal " << inputs[k].name << ": Too many values\n";
 	throw std::runtime_error(errStrStream.str() );
     }
     for (uint i = 0; i<v.size(); i++){
       try {
-	// std::cout << it.key() << "," << i << " => " << Fr_element2str(&(v[i])) << '\n';
+	// std::cout << inputs[k].name << "," << i << " => " << Fr_element2str(&(v[i])) << '\n';
 	ctx->setInputSignal(h,i,v[i]);
       } catch (std::runtime_error e) {
 	std::ostringstream errStrStream;
-	errStrStream << "Error setting signal: " << it.key() << "\n" << e.what();
+	errStrStream << "Error setting signal: " << inputs[k].name << "\n" << e.what();
 	throw std::runtime_error(errStrStream.str() );
       }
     }
   }
 }
 
+void loadJson(Circom_Circuit *circuit, Circom_CalcWit *ctx, std::string filename) {
+  std::vector<InputSignal> inputs = readJsonInputs(circuit, filename);
+  setInputs(ctx, inputs);
+}
+
 void writeBinWitness(Circom_CalcWit *ctx, std::string wtnsFileName) {
     FILE *write_ptr;
 
@@ -194,31 +261,211 @@ void writeBinWitness(Circom_CalcWit *ctx, std::string wtnsFileName) {
     fwrite(&idSection2length, 8, 1, write_ptr);
 
     FrElement v;
+    u64 *buff = new u64[(u64)Nwtns*Fr_N64];
 
     for (int i=0;i<Nwtns;i++) {
         ctx->getWitness(i, &v);
         Fr_toLongNormal(&v, &v);
-        fwrite(v.longVal, Fr_N64*8, 1, write_ptr);
+        for (int k=0;k<Fr_N64;k++) buff[(u64)i*Fr_N64+k] = v.longVal[k];
     }
+    fwrite(buff, n8, Nwtns, write_ptr);
+    delete[] buff;
     fclose(write_ptr);
 }
 
+// Runs the witness computation iterations times on fresh contexts and
+// reports the run (input setting and template execution) and write phases
+void benchmark(Circom_Circuit *circuit, std::string jsonfile, std::string wtnsfile, uint iterations, bool native, bool memoize) {
+  std::vector<InputSignal> inputs = readJsonInputs(circuit, jsonfile);
+  double runTotal = 0, runMin = 0, writeTotal = 0, writeMin = 0;
+  u64 storeBytes = 0, longValues = 0;
+  std::string memoStats;
+  for (uint i = 0; i < iterations; i++) {
+    auto t_start = std::chrono::high_resolution_clock::now();
+    Circom_CalcWit *ctx = new Circom_CalcWit(circuit);
+    ctx->nativeEngine = native;
+    ctx->memoize = memoize;
+    setInputs(ctx, inputs);
+    auto t_mid = std::chrono::high_resolution_clock::now();
+    writeBinWitness(ctx,wtnsfile);
+    auto t_end = std::chrono::high_resolution_clock::now();
+    storeBytes = ctx->signalValues.memoryUsage();
+    longValues = ctx->signalValues.longValues();
+    memoStats = ctx->memoStats();
+    delete ctx;
+
+    double run = std::chrono::duration<double, std::milli>(t_mid-t_start).count();
+    double write = std::chrono::duration<double, std::milli>(t_end-t_mid).count();
+    runTotal += run;
+    writeTotal += write;
+    if (i == 0 || run < runMin) runMin = run;
+    if (i == 0 || write < writeMin) writeMin = write;
+  }
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << "iterations: " << iterations << std::endl;
+  std::cout << "run:   avg " << runTotal/iterations << " ms, min " << runMin << " ms" << std::endl;
+  std::cout << "write: avg " << writeTotal/iterations << " ms, min " << writeMin << " ms" << std::endl;
+  std::cout << "signals: " << get_total_signal_no() << ", long values " << longValues
+            << ", store " << storeBytes << " bytes (" << (u64)get_total_signal_no()*sizeof(FrElement)
+            << " as FrElement)" << std::endl;
+  std::cout << "slots: " << get_size_of_witness() << " witness, "
+            << circuit->slotNo - get_size_of_witness() << " scratch" << std::endl;
+  std::cout << memoStats;
+}
+
+// Index of the first witness entry where both contexts differ, -1 if none
+int64_t compareWitness(Circom_CalcWit *a, Circom_CalcWit *b) {
+  FrElement va, vb;
+  for (uint i = 0; i < get_size_of_witness(); i++) {
+    a->getWitness(i, &va);
+    b->getWitness(i, &vb);
+    Fr_toLongNormal(&va, &va);
+    Fr_toLongNormal(&vb, &vb);
+    for (int k = 0; k < Fr_N64; k++) {
+      if (va.longVal[k] != vb.longVal[k]) return i;
+    }
+  }
+  return -1;
+}
+
+// Computes the witness of the json input and of boards random boards with
+// both engines and checks they are identical. A batch circuit gets as many
+// random boards per input. Returns the failures count.
+uint verifyNative(Circom_Circuit *circuit, std::string jsonfile, uint boards) {
+  uint failed = 0;
+  SudokuNativeCircuit c;
+  if (!sudoku_native_circuit(c)) {
+    std::cerr << "not a Sudoku or SudokuBatch circuit of sudoku_templates.circom, the native engine is not used" << std::endl;
+    return 1;
+  }
+  uint boardCells = c.sqrtN*c.sqrtN*c.sqrtN*c.sqrtN;
+  uint cells = c.boards*boardCells;
+  for (uint b = 0; b <= boards; b++) {
+    std::vector<InputSignal> inputs;
+    if (b == 0) {
+      inputs = readJsonInputs(circuit, jsonfile);
+    } else {
+      std::vector<int> unsolved(cells), solved(cells);
+      for (uint k = 0; k < c.boards; k++) {
+        sudoku_random_board(b*c.boards + k, c.sqrtN, &unsolved[k*boardCells], &solved[k*boardCells]);
+      }
+      InputSignal u, s;
+      u.name = "unsolved";
+      s.name = "solved";
+      for (uint i = 0; i < cells; i++) {
+        FrElement e;
+        e.type = Fr_SHORT;
+        e.shortVal = unsolved[i];
+        u.values.push_back(e);
+        e.shortVal = solved[i];
+        s.values.push_back(e);
+      }
+      inputs.push_back(u);
+      inputs.push_back(s);
+    }
+
+    Circom_CalcWit *generic = new Circom_CalcWit(circuit);
+    setInputs(generic, inputs);
+    Circom_CalcWit *native = new Circom_CalcWit(circuit);
+    native->nativeEngine = true;
+    setInputs(native, inputs);
+
+    int64_t diff = compareWitness(generic, native);
+    if (!native->nativeEngine) {
+      std::cerr << "board " << b << ": native engine not used" << std::endl;
+      failed++;
+    } else if (diff >= 0) {
+      std::cerr << "board " << b << ": witness differs at " << diff << std::endl;
+      failed++;
+    }
+    delete generic;
+    delete native;
+  }
+  std::cout << "verified " << boards+1 << " boards, " << failed << " failed" << std::endl;
+  return failed;
+}
+
+// Groth16 proof of the witness of ctx with the native prover, written as
+// snarkjs writes proof.json and public.json
+void proveWitness(Circom_CalcWit *ctx, std::string zkeyFileName, std::string proofFileName, std::string publicFileName) {
+    Groth16_ZKey zkey;
+    Groth16_readZKey(zkeyFileName, zkey);
+    uint Nwtns = get_size_of_witness();
+    if (zkey.nVars != Nwtns) {
+        throw std::runtime_error(zkeyFileName + ": the key has " + std::to_string(zkey.nVars) + " signals, the witness " + std::to_string(Nwtns));
+    }
+
+    FrElement v;
+    std::vector<uint64_t> witness((u64)Nwtns*Fr_N64);
+    for (uint i=0;i<Nwtns;i++) {
+        ctx->getWitness(i, &v);
+        Fr_toLongNormal(&v, &v);
+        for (int k=0;k<Fr_N64;k++) witness[(u64)i*Fr_N64+k] = v.longVal[k];
+    }
+
+    Groth16_Proof proof;
+    Groth16_prove(zkey, &witness[0], proof, ctx->maxThread);
+
+    std::ofstream proofFile(proofFileName);
+    proofFile << Groth16_proofJson(proof);
+    std::ofstream publicFile(publicFileName);
+    publicFile << Groth16_publicJson(zkey, &witness[0]);
+    if (!proofFile || !publicFile) throw std::runtime_error("cannot write " + proofFileName + " or " + publicFileName);
+}
+
 int main (int argc, char *argv[]) {
   std::string cl(argv[0]);
-  if (argc!=3) {
-        std::cout << "Usage: " << cl << " <input.json> <output.wtns>\n";
+  uint benchIterations = 0;
+  uint verifyBoards = 0;
+  bool verify = false;
+  std::string zkeyFile, proofFile, publicFile;
+  bool native = false;
+  bool memoize = true;
+  bool badArgs = argc < 3;
+  for (int i = 3; i < argc; i++) {
+    std::string opt(argv[i]);
+    if (opt == "--bench" && i+1 < argc) {
+      benchIterations = atoi(argv[++i]);
+    } else if (opt == "--engine" && i+1 < argc) {
+      std::string engine(argv[++i]);
+      if (engine == "native") native = true;
+      else if (engine != "generic") badArgs = true;
+    } else if (opt == "--no-memo") {
+      memoize = false;
+    } else if (opt == "--verify-native" && i+1 < argc) {
+      verify = true;
+      verifyBoards = atoi(argv[++i]);
+    } else if (opt == "--prove" && i+3 < argc) {
+      zkeyFile = argv[++i];
+      proofFile = argv[++i];
+      publicFile = argv[++i];
+    } else {
+      badArgs = true;
+    }
+  }
+  if (badArgs) {
+        std::cout << "Usage: " << cl << " <input.json> <output.wtns> [--engine generic|native] [--no-memo] [--bench <iterations>] [--verify-native <boards>] [--prove <circuit.zkey> <proof.json> <public.json>]\n";
   } else {
     std::string datfile = cl + ".dat";
     std::string jsonfile(argv[1]);
     std::string wtnsfile(argv[2]);
-  
-    // auto t_start = std::chrono::high_resolution_clock::now();
 
    Circom_Circuit *circuit = loadCircuit(datfile);
 
+   if (verify) {
+     return verifyNative(circuit, jsonfile, verifyBoards) ? EXIT_FAILURE : 0;
+   }
+
+   if (benchIterations > 0) {
+     benchmark(circuit, jsonfile, wtnsfile, benchIterations, native, memoize);
+     return 0;
+   }
+
    Circom_CalcWit *ctx = new Circom_CalcWit(circuit);
+   ctx->nativeEngine = native;
+   ctx->memoize = memoize;
   
-   loadJson(ctx, jsonfile);
+   loadJson(circuit, ctx, jsonfile);
    if (ctx->getRemaingInputsToBeSet()!=0) {
      std::cerr << "Not all inputs have been set. Only " << get_main_input_signal_no()-ctx->getRemaingInputsToBeSet() << " out of " << get_main_input_signal_no() << std::endl;
      assert(false);
@@ -230,15 +477,17 @@ int main (int argc, char *argv[]) {
      std::cout << i << ": " << Fr_element2str(&x) << std::endl;
      }
    */
-  
-   //auto t_mid = std::chrono::high_resolution_clock::now();
-   //std::cout << std::chrono::duration<double, std::milli>(t_mid-t_start).count()<<std::endl;
 
    writeBinWitness(ctx,wtnsfile);
-  
-   //auto t_end = std::chrono::high_resolution_clock::now();
-   //std::cout << std::chrono::duration<double, std::milli>(t_end-t_mid).count()<<std::endl;
+
+   if (!zkeyFile.empty()) {
+     try {
+       proveWitness(ctx, zkeyFile, proofFile, publicFile);
+     } catch (std::exception &e) {
+       std::cerr << e.what() << std::endl;
+       return EXIT_FAILURE;
+     }
+   }
 
   }  
 }
-
@@ -0,0 +1,213 @@
+#ifndef __MSM_H
+#define __MSM_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "curve.hpp"
+
+/*
+Multi scalar multiplication sum(scalars[i]*bases[i]) with the bucket method
+of Pippenger. The scalars, Fr_N64 normal form limbs each, are cut in
+windows of c bits. In every window each point is added to the bucket of its
+digit and the buckets are summed with a running sum, so a window costs n
+additions plus 2^(c+1) bucket additions instead of n full multiplications.
+
+msm is the one the prover uses. Witnesses are mostly zeros, ones and small
+numbers, so it first sorts the scalars: zeros are skipped, the points of
+ones are added up directly, and the scalars below 2^64 only get windows up
+to the bit length of the largest of them, one or two windows for the
+digits of a board. The rest get windows over the full 254 bits. The digits
+are signed, from -2^(c-1) + 1 to 2^(c-1), a negative digit adds the
+negated point, so a window needs half the buckets. Threads take whole
+windows, each with its own buckets, and the window sums are joined with c
+doublings each.
+
+msm_generic is the plain version, unsigned digits and threads splitting the
+points, kept to compare against.
+*/
+
+#define MSM_SCALAR_BITS 254
+
+// Bits [pos, pos+c) of a little endian scalar
+inline uint64_t msm_digit(const uint64_t *scalar, unsigned pos, unsigned c) {
+    unsigned limb = pos >> 6;
+    unsigned shift = pos & 0x3F;
+    if (limb >= Fr_N64) return 0;
+    uint64_t d = scalar[limb] >> shift;
+    if (shift + c > 64 && limb + 1 < Fr_N64) d |= scalar[limb + 1] << (64 - shift);
+    return d & (((uint64_t)1 << c) - 1);
+}
+
+// About ln(n) + 2, the window size that balances point and bucket additions
+inline unsigned msm_window(uint64_t n) {
+    if (n < 32) return 3;
+    unsigned log2n = 0;
+    while (((uint64_t)1 << (log2n + 1)) <= n) log2n++;
+    return log2n*69/100 + 2;
+}
+
+template <class F>
+CurvePoint<F> msm_generic_range(const CurveAffine<F> *bases, const uint64_t *scalars, uint64_t n, unsigned c) {
+    const unsigned nWindows = (MSM_SCALAR_BITS + c - 1) / c;
+    std::vector<CurvePoint<F>> buckets(((uint64_t)1 << c) - 1);
+    CurvePoint<F> r;
+    for (int w = nWindows - 1; w >= 0; w--) {
+        for (unsigned k = 0; k < c; k++) r = r.dbl();
+        for (auto &b : buckets) b = CurvePoint<F>::zero();
+        for (uint64_t i = 0; i < n; i++) {
+            uint64_t d = msm_digit(&scalars[i*Fr_N64], w*c, c);
+            if (d) buckets[d-1] += bases[i];
+        }
+        // sum d*buckets[d-1] as the sum of the running sums from the top
+        CurvePoint<F> running, sum;
+        for (int64_t d = buckets.size() - 1; d >= 0; d--) {
+            running += buckets[d];
+            sum += running;
+        }
+        r += sum;
+    }
+    return r;
+}
+
+template <class F>
+CurvePoint<F> msm_generic(const CurveAffine<F> *bases, const uint64_t *scalars, uint64_t n, unsigned nThreads) {
+    if (n == 0) return CurvePoint<F>::zero();
+    if (nThreads > n) nThreads = n;
+    if (nThreads <= 1) return msm_generic_range(bases, scalars, n, msm_window(n));
+
+    const uint64_t perThread = (n + nThreads - 1) / nThreads;
+    const unsigned c = msm_window(perThread);
+    std::vector<CurvePoint<F>> partial(nThreads);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < nThreads; t++) {
+        uint64_t start = t*perThread;
+        uint64_t size = start >= n ? 0 : (n - start < perThread ? n - start : perThread);
+        threads.push_back(std::thread([&, t, start, size]() {
+            partial[t] = msm_generic_range(&bases[start], &scalars[start*Fr_N64], size, c);
+        }));
+    }
+    for (auto &th : threads) th.join();
+
+    CurvePoint<F> r;
+    for (auto &p : partial) r += p;
+    return r;
+}
+
+// Runs f(t) for t in [0, nThreads), on the calling thread when there is one
+template <class Fn>
+void msm_parallel(unsigned nThreads, Fn f) {
+    if (nThreads <= 1) {
+        f(0);
+        return;
+    }
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < nThreads; t++) threads.push_back(std::thread(f, t));
+    for (auto &th : threads) th.join();
+}
+
+// Signed digit Pippenger over the points index[0..n) with scalars below
+// 2^bits. Window w holds digits[w*n + i] for point index[i].
+template <class F>
+CurvePoint<F> msm_signed(const CurveAffine<F> *bases, const uint64_t *scalars, const std::vector<uint64_t> &index,
+                         unsigned bits, unsigned nThreads) {
+    const uint64_t n = index.size();
+    if (n == 0) return CurvePoint<F>::zero();
+    // small scalars need no more buckets than their values
+    const unsigned c = msm_window(n) < bits + 1 ? msm_window(n) : bits + 1;
+    // one more window than bits/c for the carry of the top digit
+    const unsigned nWindows = (bits + c) / c;
+    const int64_t half = (int64_t)1 << (c - 1);
+
+    std::vector<int32_t> digits((uint64_t)nWindows*n);
+    const uint64_t perThread = (n + nThreads - 1) / nThreads;
+    msm_parallel(nThreads, [&](unsigned t) {
+        uint64_t end = (t + 1)*perThread < n ? (t + 1)*perThread : n;
+        for (uint64_t i = t*perThread; i < end; i++) {
+            const uint64_t *s = &scalars[index[i]*Fr_N64];
+            int64_t carry = 0;
+            for (unsigned w = 0; w < nWindows; w++) {
+                int64_t d = (int64_t)msm_digit(s, w*c, c) + carry;
+                carry = d > half;
+                digits[(uint64_t)w*n + i] = (int32_t)(d - (carry << c));
+            }
+        }
+    });
+
+    std::vector<CurvePoint<F>> windows(nWindows);
+    std::atomic<unsigned> next(0);
+    msm_parallel(nThreads < nWindows ? nThreads : nWindows, [&](unsigned) {
+        std::vector<CurvePoint<F>> buckets(half);
+        unsigned w;
+        while ((w = next++) < nWindows) {
+            for (auto &b : buckets) b = CurvePoint<F>::zero();
+            const int32_t *wd = &digits[(uint64_t)w*n];
+            for (uint64_t i = 0; i < n; i++) {
+                int32_t d = wd[i];
+                if (d > 0) {
+                    buckets[d - 1] += bases[index[i]];
+                } else if (d < 0) {
+                    const CurveAffine<F> &p = bases[index[i]];
+                    buckets[-d - 1] += CurveAffine<F>{p.x, -p.y};
+                }
+            }
+            CurvePoint<F> running, sum;
+            for (int64_t d = half - 1; d >= 0; d--) {
+                running += buckets[d];
+                sum += running;
+            }
+            windows[w] = sum;
+        }
+    });
+
+    CurvePoint<F> r = windows[nWindows - 1];
+    for (int w = nWindows - 2; w >= 0; w--) {
+        for (unsigned k = 0; k < c; k++) r = r.dbl();
+        r += windows[w];
+    }
+    return r;
+}
+
+template <class F>
+CurvePoint<F> msm(const CurveAffine<F> *bases, const uint64_t *scalars, uint64_t n, unsigned nThreads) {
+    if (n == 0) return CurvePoint<F>::zero();
+    if (nThreads == 0) nThreads = 1;
+    if (nThreads > n) nThreads = n;
+
+    // Sort the scalars by size, threads take contiguous ranges and add up
+    // the points of their ones
+    const uint64_t perThread = (n + nThreads - 1) / nThreads;
+    std::vector<CurvePoint<F>> ones(nThreads);
+    std::vector<std::vector<uint64_t>> shortIndex(nThreads), fullIndex(nThreads);
+    std::vector<uint64_t> shortMax(nThreads, 0);
+    msm_parallel(nThreads, [&](unsigned t) {
+        uint64_t end = (t + 1)*perThread < n ? (t + 1)*perThread : n;
+        for (uint64_t i = t*perThread; i < end; i++) {
+            const uint64_t *s = &scalars[i*Fr_N64];
+            if (s[1] | s[2] | s[3]) {
+                fullIndex[t].push_back(i);
+            } else if (s[0] == 1) {
+                ones[t] += bases[i];
+            } else if (s[0] != 0) {
+                shortIndex[t].push_back(i);
+                if (s[0] > shortMax[t]) shortMax[t] = s[0];
+            }
+        }
+    });
+
+    CurvePoint<F> r;
+    std::vector<uint64_t> shortAll, fullAll;
+    unsigned shortBits = 0;
+    for (unsigned t = 0; t < nThreads; t++) {
+        r += ones[t];
+        while (shortBits < 64 && (shortMax[t] >> shortBits)) shortBits++;
+        shortAll.insert(shortAll.end(), shortIndex[t].begin(), shortIndex[t].end());
+        fullAll.insert(fullAll.end(), fullIndex[t].begin(), fullIndex[t].end());
+    }
+    r += msm_signed(bases, scalars, shortAll, shortBits, nThreads);
+    r += msm_signed(bases, scalars, fullAll, MSM_SCALAR_BITS, nThreads);
+    return r;
+}
+
+#endif // __MSM_H
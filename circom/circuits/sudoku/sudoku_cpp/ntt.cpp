@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "ntt.hpp"
+
+static RawFr &F = RawFr::field;
+
+// Runs f(from, to) on count items split in contiguous ranges over the
+// threads, on the calling thread when there is one
+template <class Fn>
+static void parallelFor(unsigned int nThreads, uint64_t count, Fn f) {
+    if (nThreads > count) nThreads = count;
+    if (nThreads <= 1) {
+        f(0, count);
+        return;
+    }
+    const uint64_t perThread = (count + nThreads - 1) / nThreads;
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < nThreads; t++) {
+        uint64_t from = t*perThread;
+        uint64_t to = std::min(count, from + perThread);
+        if (from < to) threads.push_back(std::thread(f, from, to));
+    }
+    for (auto &th : threads) th.join();
+}
+
+// Radix-2 stage with half h = 2^s, butterflies [from, to) of the n/2
+static void radix2(RawFr::Element *a, RawFr::Element *tw, unsigned int s, uint64_t from, uint64_t to) {
+    const uint64_t h = (uint64_t)1 << s;
+    RawFr::Element t;
+    for (uint64_t j = from; j < to; j++) {
+        const uint64_t k = j & (h - 1);
+        RawFr::Element *x = &a[((j >> s) << (s + 1)) + k];
+        F.mul(t, tw[h + k], x[h]);
+        F.sub(x[h], x[0], t);
+        F.add(x[0], x[0], t);
+    }
+}
+
+// The stages with half h = 2^s and 2h in one pass, butterflies [from, to)
+// of the n/4, each on the 4 elements h apart
+static void radix4(RawFr::Element *a, RawFr::Element *tw, unsigned int s, uint64_t from, uint64_t to) {
+    const uint64_t h = (uint64_t)1 << s;
+    RawFr::Element t0, t1, x0, x1, x2, x3;
+    for (uint64_t j = from; j < to; j++) {
+        const uint64_t k = j & (h - 1);
+        RawFr::Element *x = &a[((j >> s) << (s + 2)) + k];
+
+        // half h, the same twiddle for both pairs
+        F.mul(t0, tw[h + k], x[h]);
+        F.mul(t1, tw[h + k], x[3*h]);
+        F.add(x0, x[0], t0);
+        F.sub(x1, x[0], t0);
+        F.add(x2, x[2*h], t1);
+        F.sub(x3, x[2*h], t1);
+
+        // half 2h, elements k and k + h of the block of 4h
+        F.mul(t0, tw[2*h + k], x2);
+        F.mul(t1, tw[3*h + k], x3);
+        F.add(x[0], x0, t0);
+        F.sub(x[2*h], x0, t0);
+        F.add(x[h], x1, t1);
+        F.sub(x[3*h], x1, t1);
+    }
+}
+
+// Stages [from, to) on n = 2^bits elements, radix-4 pairs and a last
+// radix-2 stage when their count is odd
+static void stages(RawFr::Element *a, RawFr::Element *tw, unsigned int bits, unsigned int from, unsigned int to, unsigned int nThreads) {
+    unsigned int s = from;
+    for (; s + 1 < to; s += 2) {
+        parallelFor(nThreads, (uint64_t)1 << (bits - 2), [=](uint64_t b, uint64_t e) { radix4(a, tw, s, b, e); });
+    }
+    if (s < to) {
+        parallelFor(nThreads, (uint64_t)1 << (bits - 1), [=](uint64_t b, uint64_t e) { radix2(a, tw, s, b, e); });
+    }
+}
+
+FrValue Ntt::root(unsigned int bits) {
+    FrValue w = FrValue::fromString("19103219067921713944291392827692070036145651957329286315305642004821462161904");
+    for (unsigned int i = bits; i < NTT_MAX_BITS; i++) w = w.square();
+    return w;
+}
+
+Ntt::Ntt(unsigned int bits) : nBits(bits), twiddles(bits ? (uint64_t)1 << bits : 1) {
+    if (bits == 0) return;
+    // The top level from powers of the root, a level below takes every
+    // second root of the level above
+    const uint64_t top = (uint64_t)1 << (bits - 1);
+    RawFr::Element w;
+    F.fromValue(w, root(bits));
+    F.copy(twiddles[top], F.one());
+    for (uint64_t k = 1; k < top; k++) F.mul(twiddles[top + k], twiddles[top + k - 1], w);
+    for (uint64_t h = top/2; h >= 1; h /= 2) {
+        for (uint64_t k = 0; k < h; k++) F.copy(twiddles[h + k], twiddles[2*h + 2*k]);
+    }
+}
+
+const Ntt &Ntt::get(unsigned int bits) {
+    static std::mutex mutex;
+    static Ntt *instances[NTT_MAX_BITS+1] = {};
+    if (bits > NTT_MAX_BITS) {
+        throw std::runtime_error("Ntt: domain larger than 2^28");
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!instances[bits]) instances[bits] = new Ntt(bits);
+    return *instances[bits];
+}
+
+void Ntt::fft(RawFr::Element *a, unsigned int nThreads) const {
+    const uint64_t n = (uint64_t)1 << nBits;
+    for (uint64_t i = 1, j = 0; i < n; i++) {
+        uint64_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) F.swap(a[i], a[j]);
+    }
+
+    // Blocks in cache first, each thread takes whole blocks
+    RawFr::Element *tw = &twiddles[0];
+    const unsigned int blockBits = std::min(nBits, (unsigned int)NTT_BLOCK_BITS);
+    parallelFor(nThreads, n >> blockBits, [=](uint64_t b, uint64_t e) {
+        for (uint64_t block = b; block < e; block++) {
+            stages(&a[block << blockBits], tw, blockBits, 0, blockBits, 1);
+        }
+    });
+
+    stages(a, tw, nBits, blockBits, nBits, nThreads);
+}
+
+void Ntt::ifft(RawFr::Element *a, unsigned int nThreads) const {
+    const uint64_t n = (uint64_t)1 << nBits;
+    fft(a, nThreads);
+    std::reverse(a + 1, a + n);
+    RawFr::Element nInv;
+    F.fromValue(nInv, FrValue(n).inv());
+    parallelFor(nThreads, n, [=](uint64_t b, uint64_t e) {
+        RawFr::Element f = nInv;
+        for (uint64_t i = b; i < e; i++) F.mul(a[i], a[i], f);
+    });
+}
+
+void Ntt::shift(RawFr::Element *a, const FrValue &g, unsigned int nThreads) const {
+    const uint64_t n = (uint64_t)1 << nBits;
+    parallelFor(nThreads, n, [=](uint64_t b, uint64_t e) {
+        RawFr::Element f, step;
+        F.fromValue(f, g.pow(b));
+        F.fromValue(step, g);
+        for (uint64_t i = b; i < e; i++) {
+            F.mul(a[i], a[i], f);
+            F.mul(f, f, step);
+        }
+    });
+}
@@ -0,0 +1,58 @@
+#ifndef NTT_H
+#define NTT_H
+
+#include <vector>
+
+#include "fr.hpp"
+
+/*
+Number theoretic transforms over the BN254 scalar field on RawFr elements in
+Montgomery form, with the roots of unity of snarkjs: ffjavascript starts
+from a root of order 2^28 and squares down, w[i] = w[i+1]^2.
+
+The twiddles are computed once per domain size, level by level: the h
+roots of order 2h are at twiddles[h..2h), so every stage reads them in
+order. Two radix-2 stages are done as one radix-4 pass, which reads and
+writes the array once for both. The stages of blocks up to
+2^NTT_BLOCK_BITS elements run block by block while the block is in cache,
+with threads taking whole blocks. The larger stages split their butterflies
+over the threads.
+
+The inverse transform is the forward one with the outputs 1..n-1 in
+reverse order, scaled by 1/n, so there is a single table per size.
+*/
+
+#define NTT_MAX_BITS 28
+#define NTT_BLOCK_BITS 12
+
+class Ntt {
+
+public:
+
+    // The instance for domains of size 2^bits, bits <= NTT_MAX_BITS
+    static const Ntt &get(unsigned int bits);
+
+    // The root of unity of order 2^bits
+    static FrValue root(unsigned int bits);
+
+    unsigned int bits() const { return nBits; }
+
+    // In place, the evaluations at w^i of the polynomial with coefficients a
+    void fft(RawFr::Element *a, unsigned int nThreads = 1) const;
+
+    // In place, the coefficients of the polynomial with evaluations a at w^i
+    void ifft(RawFr::Element *a, unsigned int nThreads = 1) const;
+
+    // a[i] *= g^i, the polynomial p(x) to p(g*x)
+    void shift(RawFr::Element *a, const FrValue &g, unsigned int nThreads = 1) const;
+
+private:
+
+    unsigned int nBits;
+    // mutable as RawFr takes its operands by non const reference
+    mutable std::vector<RawFr::Element> twiddles;
+
+    Ntt(unsigned int bits);
+};
+
+#endif // NTT_H
@@ -0,0 +1,193 @@
+#include "pairing.hpp"
+
+// NAF of 6x + 2, x = 4965661367192848881, least significant digit first
+static const int8_t ateLoopNaf[] = {
+    0, 0, 0, 1, 0, 1, 0, -1, 0, 0, -1, 0, 0, 0, 1, 0, 0, -1, 0, -1, 0, 0, 0, 1, 0, -1, 0, 0, 0, 0, -1, 0,
+    0, 1, 0, -1, 0, 0, 1, 0, 0, 0, 0, 0, -1, 0, 0, -1, 0, 1, 0, -1, 0, 0, 0, -1, 0, -1, 0, 0, 0, 1, 0, -1,
+    0, 1
+};
+static const int ateLoopBits = sizeof(ateLoopNaf);
+
+// (q^6 + 1)/r, the final exponent after f^(q^6 - 1)
+static const uint64_t finalExponent[] = {
+    0x5250a54036e3f812ULL, 0xa5635f1596789051ULL, 0xd1138bf54d5bd1d4ULL, 0xa8ce2533be36c7a2ULL,
+    0x94f69f6b84e09bf6ULL, 0x42ad1f5e50ef3644ULL, 0x0fcc420e48c3454cULL, 0x758e4408ecc9952cULL,
+    0xc901bf1887c6042cULL, 0xa733cd65b14bb3b5ULL, 0xdf6d76bdcf51b0d8ULL, 0xca64c0fd82eb59e1ULL,
+    0x1d2e5726e39276a1ULL, 0xc2d1ea74a391cae9ULL, 0x07409206c82d647eULL, 0x051c6d1aa5afdd17ULL,
+    0xb37f601919667af5ULL, 0x150e578c5084015bULL, 0xfbdea556c23998e4ULL, 0x000fd14cc52f5b83ULL
+};
+
+// 6x^2
+static const uint64_t sixXSquare[Fr_N64] = {0xf83e9682e87cfd46ULL, 0x6f4d8248eeb859fbULL, 0, 0};
+
+// (9 + u)^((q - 1)/3), (9 + u)^((q - 1)/2) and (9 + u)^((q^2 - 1)/3) for
+// the Frobenius map on the twist, (9 + u)^((q^2 - 1)/2) is -1
+static const Fq2Value &frobeniusX() {
+    static const Fq2Value g(
+        FqValue::fromString("21575463638280843010398324269430826099269044274347216827212613867836435027261"),
+        FqValue::fromString("10307601595873709700152284273816112264069230130616436755625194854815875713954"));
+    return g;
+}
+
+static const Fq2Value &frobeniusY() {
+    static const Fq2Value g(
+        FqValue::fromString("2821565182194536844548159561693502659359617185244120367078079554186484126554"),
+        FqValue::fromString("3505843767911556378687030309984248845540243509899259641013678093033130930403"));
+    return g;
+}
+
+static const FqValue &frobenius2X() {
+    static const FqValue g = FqValue::fromString("21888242871839275220042445260109153167277707414472061641714758635765020556616");
+    return g;
+}
+
+Fq12Value Fq12Value::pow(const uint64_t *e, unsigned nLimbs) const {
+    // fixed 4 bit windows
+    Fq12Value table[16];
+    table[0] = one();
+    for (int i = 1; i < 16; i++) table[i] = table[i-1]*(*this);
+    Fq12Value r = one();
+    bool started = false;
+    for (int i = nLimbs*16 - 1; i >= 0; i--) {
+        unsigned nibble = (e[i/16] >> ((i % 16)*4)) & 0xF;
+        if (started) r = r.square().square().square().square();
+        if (nibble) {
+            r = r*table[nibble];
+            started = true;
+        }
+    }
+    return r;
+}
+
+G2Affine G2_frobenius(const G2Affine &q) {
+    if (q.isZero()) return q;
+    return G2Affine{q.x.conjugate()*frobeniusX(), q.y.conjugate()*frobeniusY()};
+}
+
+bool G2_inSubgroup(const G2Affine &q) {
+    if (!G2_isOnCurve(q)) return false;
+    if (q.isZero()) return true;
+    return G2Point(G2_frobenius(q)) == G2Point(q).mul(sixXSquare);
+}
+
+// Inverts a[0..n) in place with one inversion, every a[i] non zero
+static void batchInverse(std::vector<Fq2Value> &a) {
+    const uint64_t n = a.size();
+    if (n == 0) return;
+    std::vector<Fq2Value> prefix(n);
+    Fq2Value acc = Fq2Value::one();
+    for (uint64_t i = 0; i < n; i++) {
+        prefix[i] = acc;
+        acc = acc*a[i];
+    }
+    acc = acc.inv();
+    for (uint64_t i = n; i-- > 0;) {
+        Fq2Value inv = acc*prefix[i];
+        acc = acc*a[i];
+        a[i] = inv;
+    }
+}
+
+void pairing_prepare(const G2Affine *q, uint64_t n, G2Prepared *out) {
+    std::vector<uint64_t> active;
+    std::vector<G2Affine> t;
+    for (uint64_t i = 0; i < n; i++) {
+        out[i].infinity = q[i].isZero();
+        out[i].lambda.clear();
+        out[i].c.clear();
+        if (!out[i].infinity) {
+            active.push_back(i);
+            t.push_back(q[i]);
+        }
+    }
+    const uint64_t m = active.size();
+    std::vector<Fq2Value> d(m);
+
+    // T = 2T, the line is the tangent
+    auto dbl = [&]() {
+        for (uint64_t j = 0; j < m; j++) d[j] = t[j].y.dbl();
+        batchInverse(d);
+        for (uint64_t j = 0; j < m; j++) {
+            G2Affine &tj = t[j];
+            Fq2Value x2 = tj.x.square();
+            Fq2Value l = (x2.dbl() + x2)*d[j];
+            Fq2Value c = l*tj.x - tj.y;
+            out[active[j]].lambda.push_back(l);
+            out[active[j]].c.push_back(c);
+            Fq2Value x = l.square() - tj.x.dbl();
+            tj.y = c - l*x;
+            tj.x = x;
+        }
+    };
+
+    // T = T + a[j], the line through both
+    auto add = [&](const std::vector<G2Affine> &a) {
+        for (uint64_t j = 0; j < m; j++) d[j] = a[j].x - t[j].x;
+        batchInverse(d);
+        for (uint64_t j = 0; j < m; j++) {
+            G2Affine &tj = t[j];
+            Fq2Value l = (a[j].y - tj.y)*d[j];
+            Fq2Value c = l*tj.x - tj.y;
+            out[active[j]].lambda.push_back(l);
+            out[active[j]].c.push_back(c);
+            Fq2Value x = l.square() - tj.x - a[j].x;
+            tj.y = c - l*x;
+            tj.x = x;
+        }
+    };
+
+    std::vector<G2Affine> qs(t), negQs(m);
+    for (uint64_t j = 0; j < m; j++) negQs[j] = G2Affine{qs[j].x, -qs[j].y};
+
+    for (int i = ateLoopBits - 2; i >= 0; i--) {
+        dbl();
+        if (ateLoopNaf[i] == 1) add(qs);
+        if (ateLoopNaf[i] == -1) add(negQs);
+    }
+
+    // Q1 = pi(Q) and -Q2 = -pi^2(Q)
+    std::vector<G2Affine> q1(m), q2(m);
+    for (uint64_t j = 0; j < m; j++) {
+        q1[j] = G2_frobenius(qs[j]);
+        q2[j] = G2Affine{qs[j].x*frobenius2X(), qs[j].y};
+    }
+    add(q1);
+    add(q2);
+}
+
+Fq12Value pairing_millerLoop(const G1Affine *p, const G2Prepared *q, uint64_t n) {
+    std::vector<uint64_t> pairs;
+    for (uint64_t i = 0; i < n; i++) {
+        if (!p[i].isZero() && !q[i].infinity) pairs.push_back(i);
+    }
+    Fq12Value f = Fq12Value::one();
+    size_t step = 0;
+    auto lines = [&]() {
+        for (uint64_t i : pairs) {
+            const G2Prepared &qi = q[i];
+            f = f.mulByLine(p[i].y, -(qi.lambda[step]*p[i].x), qi.c[step]);
+        }
+        step++;
+    };
+
+    for (int i = ateLoopBits - 2; i >= 0; i--) {
+        f = f.square();
+        lines();
+        if (ateLoopNaf[i] != 0) lines();
+    }
+    lines();
+    lines();
+    return f;
+}
+
+Fq12Value pairing_finalExp(const Fq12Value &f) {
+    // f^(q^6 - 1), then the rest of the exponent
+    Fq12Value g = f.conjugate()*f.inv();
+    return g.pow(finalExponent, sizeof(finalExponent)/sizeof(finalExponent[0]));
+}
+
+Fq12Value pairing(const G1Affine &p, const G2Affine &q) {
+    G2Prepared prepared;
+    pairing_prepare(&q, 1, &prepared);
+    return pairing_finalExp(pairing_millerLoop(&p, &prepared, 1));
+}
@@ -0,0 +1,152 @@
+#ifndef __PAIRING_H
+#define __PAIRING_H
+
+#include <vector>
+
+#include "curve.hpp"
+
+/*
+Optimal ate pairing of BN254, the pairing of the ecPairing precompile and
+of snarkjs, on the tower
+
+    Fq6  = Fq2[v]/(v^3 - (9 + u))
+    Fq12 = Fq6[w]/(w^2 - v)
+
+so w^6 = 9 + u, and G2 is on the twist y^2 = x^3 + 3/(9 + u), mapped into
+E(Fq12) by (x, y) -> (x*w^2, y*w^3).
+
+The Miller loop runs over the NAF of 6x + 2 with the lines of G2Prepared.
+Preparing a G2 point walks its multiples in affine coordinates, and the
+points prepared together share one inversion per step. A line through T
+with slope l, evaluated at P, is yP - l*xP*w + (l*xT - yT)*w^3, so only
+l and l*xT - yT are kept per step. pairing_millerLoop multiplies the lines
+of all the pairs into one value, and a product of pairings needs a single
+pairing_finalExp.
+*/
+
+class Fq6Value {
+public:
+    Fq2Value c0;
+    Fq2Value c1;
+    Fq2Value c2;
+
+    Fq6Value() : c0(), c1(), c2() {}
+    Fq6Value(const Fq2Value &a0, const Fq2Value &a1, const Fq2Value &a2) : c0(a0), c1(a1), c2(a2) {}
+
+    static Fq6Value zero() { return Fq6Value(); }
+    static Fq6Value one() { return Fq6Value(Fq2Value::one(), Fq2Value(), Fq2Value()); }
+
+    bool operator==(const Fq6Value &b) const { return c0 == b.c0 && c1 == b.c1 && c2 == b.c2; }
+
+    // a*(9 + u)
+    static Fq2Value mulByXi(const Fq2Value &a) {
+        FqValue a0x8 = a.c0.dbl().dbl().dbl();
+        FqValue a1x8 = a.c1.dbl().dbl().dbl();
+        return Fq2Value(a0x8 + a.c0 - a.c1, a1x8 + a.c1 + a.c0);
+    }
+
+    Fq6Value operator+(const Fq6Value &b) const { return Fq6Value(c0 + b.c0, c1 + b.c1, c2 + b.c2); }
+    Fq6Value operator-(const Fq6Value &b) const { return Fq6Value(c0 - b.c0, c1 - b.c1, c2 - b.c2); }
+    Fq6Value operator-() const { return Fq6Value(-c0, -c1, -c2); }
+
+    // Karatsuba, 6 Fq2 multiplications
+    Fq6Value operator*(const Fq6Value &b) const {
+        Fq2Value t0 = c0*b.c0;
+        Fq2Value t1 = c1*b.c1;
+        Fq2Value t2 = c2*b.c2;
+        return Fq6Value(
+            t0 + mulByXi((c1 + c2)*(b.c1 + b.c2) - t1 - t2),
+            (c0 + c1)*(b.c0 + b.c1) - t0 - t1 + mulByXi(t2),
+            (c0 + c2)*(b.c0 + b.c2) - t0 - t2 + t1);
+    }
+
+    // this*(b0 + b1*v)
+    Fq6Value mulBy01(const Fq2Value &b0, const Fq2Value &b1) const {
+        return Fq6Value(c0*b0 + mulByXi(c2*b1), c0*b1 + c1*b0, c1*b1 + c2*b0);
+    }
+
+    Fq6Value mulByFq2(const Fq2Value &b) const { return Fq6Value(c0*b, c1*b, c2*b); }
+
+    // this*v
+    Fq6Value mulByV() const { return Fq6Value(mulByXi(c2), c0, c1); }
+
+    Fq6Value inv() const {
+        Fq2Value a = c0.square() - mulByXi(c1*c2);
+        Fq2Value b = mulByXi(c2.square()) - c0*c1;
+        Fq2Value c = c1.square() - c0*c2;
+        Fq2Value f = (c0*a + mulByXi(c2*b + c1*c)).inv();
+        return Fq6Value(a*f, b*f, c*f);
+    }
+};
+
+class Fq12Value {
+public:
+    Fq6Value c0;
+    Fq6Value c1;
+
+    Fq12Value() : c0(), c1() {}
+    Fq12Value(const Fq6Value &a0, const Fq6Value &a1) : c0(a0), c1(a1) {}
+
+    static Fq12Value one() { return Fq12Value(Fq6Value::one(), Fq6Value()); }
+
+    bool isOne() const { return c0 == Fq6Value::one() && c1 == Fq6Value(); }
+    bool operator==(const Fq12Value &b) const { return c0 == b.c0 && c1 == b.c1; }
+
+    Fq12Value operator*(const Fq12Value &b) const {
+        Fq6Value t0 = c0*b.c0;
+        Fq6Value t1 = c1*b.c1;
+        return Fq12Value(t0 + t1.mulByV(), (c0 + c1)*(b.c0 + b.c1) - t0 - t1);
+    }
+
+    Fq12Value square() const {
+        Fq6Value t = c0*c1;
+        Fq6Value s = (c0 + c1)*(c0 + c1.mulByV()) - t - t.mulByV();
+        return Fq12Value(s, t + t);
+    }
+
+    // this*(l0 + (l3 + l4*v)*w) with l0 in Fq, the shape of a line
+    Fq12Value mulByLine(const FqValue &l0, const Fq2Value &l3, const Fq2Value &l4) const {
+        Fq6Value t0(c0.c0*l0, c0.c1*l0, c0.c2*l0);
+        Fq6Value t1 = c1.mulBy01(l3, l4);
+        Fq2Value l03(l3.c0 + l0, l3.c1);
+        Fq6Value s = (c0 + c1).mulBy01(l03, l4);
+        return Fq12Value(t0 + t1.mulByV(), s - t0 - t1);
+    }
+
+    // The Frobenius map to the power q^6
+    Fq12Value conjugate() const { return Fq12Value(c0, -c1); }
+
+    Fq12Value inv() const {
+        Fq6Value t = (c0*c0 - (c1*c1).mulByV()).inv();
+        return Fq12Value(c0*t, -(c1*t));
+    }
+
+    // this^e, e given as nLimbs little endian limbs
+    Fq12Value pow(const uint64_t *e, unsigned nLimbs) const;
+};
+
+// Line coefficients of the Miller loop of a G2 point
+struct G2Prepared {
+    bool infinity;
+    std::vector<Fq2Value> lambda;   // slope of the line of each step
+    std::vector<Fq2Value> c;        // lambda*xT - yT
+};
+
+// Prepares n points together, one Fq2 inversion per step for all of them
+void pairing_prepare(const G2Affine *q, uint64_t n, G2Prepared *out);
+
+// Product of the Miller loops of the pairs (p[i], q[i])
+Fq12Value pairing_millerLoop(const G1Affine *p, const G2Prepared *q, uint64_t n);
+
+// f^((q^12 - 1)/r)
+Fq12Value pairing_finalExp(const Fq12Value &f);
+
+Fq12Value pairing(const G1Affine &p, const G2Affine &q);
+
+// The Frobenius endomorphism on the twist, (x, y) -> (x^q, y^q) on E(Fq12)
+G2Affine G2_frobenius(const G2Affine &q);
+
+// q is on the twist and of order r, checked as psi(q) == [6x^2]q
+bool G2_inSubgroup(const G2Affine &q);
+
+#endif // __PAIRING_H
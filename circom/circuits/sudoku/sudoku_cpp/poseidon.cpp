@@ -0,0 +1,192 @@
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "poseidon.hpp"
+
+// Partial rounds of circomlib for t = 2 .. POSEIDON_MAX_INPUTS+1
+static const unsigned int nRoundsPOf[POSEIDON_MAX_INPUTS] = {56, 57, 56, 60, 60, 63, 64, 63, 60, 66, 60, 65, 70, 60, 64, 68};
+
+#define POSEIDON_ROUNDS_F 8
+#define POSEIDON_FIELD_BITS 254
+
+static RawFr &F = RawFr::field;
+
+/*
+Grain LFSR of generate_parameters_grain.sage, seeded with the field type
+(prime), the S-box (x^alpha), the field size, t and the round numbers.
+*/
+class PoseidonGrain {
+    uint8_t state[80];
+    unsigned int head;
+
+    uint8_t next() {
+        uint8_t bit = state[(head + 62) % 80] ^ state[(head + 51) % 80] ^ state[(head + 38) % 80]
+                    ^ state[(head + 23) % 80] ^ state[(head + 13) % 80] ^ state[head];
+        state[head] = bit;
+        head = (head + 1) % 80;
+        return bit;
+    }
+
+    void seed(unsigned int &pos, uint64_t v, unsigned int nBits) {
+        for (int i = nBits-1; i >= 0; i--) state[pos++] = (v >> i) & 1;
+    }
+
+public:
+
+    PoseidonGrain(unsigned int t, unsigned int nRoundsF, unsigned int nRoundsP) : head(0) {
+        unsigned int pos = 0;
+        seed(pos, 1, 2);
+        seed(pos, 0, 4);
+        seed(pos, POSEIDON_FIELD_BITS, 12);
+        seed(pos, t, 12);
+        seed(pos, nRoundsF, 10);
+        seed(pos, nRoundsP, 10);
+        while (pos < 80) state[pos++] = 1;
+        for (int i = 0; i < 160; i++) next();
+    }
+
+    // Of each pair of bits the second one is kept when the first one is set
+    uint8_t bit() {
+        for (;;) {
+            uint8_t keep = next();
+            uint8_t b = next();
+            if (keep) return b;
+        }
+    }
+
+    // nBits bits, the first one the most significant, as 4 normal limbs
+    void bits(uint64_t *v, unsigned int nBits) {
+        for (int i = 0; i < Fr_N64; i++) v[i] = 0;
+        for (int i = nBits-1; i >= 0; i--) v[i >> 6] |= (uint64_t)bit() << (i & 0x3F);
+    }
+};
+
+static bool lessThanQ(const uint64_t *v) {
+    for (int i = Fr_N64-1; i >= 0; i--) {
+        if (v[i] != Fr_rawq[i]) return v[i] < Fr_rawq[i];
+    }
+    return false;
+}
+
+Poseidon::Poseidon(unsigned int nInputs) {
+    t = nInputs + 1;
+    nRoundsF = POSEIDON_ROUNDS_F;
+    nRoundsP = nRoundsPOf[t-2];
+
+    PoseidonGrain grain(t, nRoundsF, nRoundsP);
+    uint64_t v[Fr_N64];
+
+    // Round constants are sampled again until they are below q
+    C.resize((nRoundsF + nRoundsP)*t);
+    for (size_t i = 0; i < C.size(); i++) {
+        do {
+            grain.bits(v, POSEIDON_FIELD_BITS);
+        } while (!lessThanQ(v));
+        F.fromValue(C[i], FrValue::fromNormal(v[0], v[1], v[2], v[3]));
+    }
+
+    // Cauchy matrix 1/(x[i] + y[j]) of 2t reduced samples
+    std::vector<FrValue> xy(2*t);
+    for (unsigned int i = 0; i < 2*t; i++) {
+        grain.bits(v, POSEIDON_FIELD_BITS);
+        xy[i] = FrValue::fromNormal(v[0], v[1], v[2], v[3]);
+    }
+    M.resize(t*t);
+    for (unsigned int i = 0; i < t; i++) {
+        for (unsigned int j = 0; j < t; j++) {
+            F.fromValue(M[i*t + j], (xy[i] + xy[t + j]).inv());
+        }
+    }
+}
+
+const Poseidon &Poseidon::get(unsigned int nInputs) {
+    static std::mutex mutex;
+    static Poseidon *instances[POSEIDON_MAX_INPUTS+1] = {};
+    if (nInputs < 1 || nInputs > POSEIDON_MAX_INPUTS) {
+        throw std::runtime_error("Poseidon: unsupported number of inputs");
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!instances[nInputs]) instances[nInputs] = new Poseidon(nInputs);
+    return *instances[nInputs];
+}
+
+// s holds LANES states of t elements, lane after lane
+template <unsigned int LANES>
+void Poseidon::permute(RawFr::Element *s) const {
+    RawFr::Element mixed[POSEIDON_MAX_INPUTS+1];
+    RawFr::Element sq;
+    RawFr::Element prod;
+    const unsigned int halfF = nRoundsF/2;
+
+    for (unsigned int r = 0; r < nRoundsF + nRoundsP; r++) {
+        RawFr::Element *c = &C[r*t];
+        const bool full = r < halfF || r >= halfF + nRoundsP;
+        const unsigned int sboxes = full ? t : 1;
+
+        for (unsigned int l = 0; l < LANES; l++) {
+            for (unsigned int i = 0; i < t; i++) F.add(s[l*t + i], s[l*t + i], c[i]);
+        }
+        for (unsigned int i = 0; i < sboxes; i++) {
+            for (unsigned int l = 0; l < LANES; l++) {
+                RawFr::Element &x = s[l*t + i];
+                F.square(sq, x);
+                F.square(sq, sq);
+                F.mul(x, sq, x);
+            }
+        }
+        for (unsigned int l = 0; l < LANES; l++) {
+            RawFr::Element *ls = &s[l*t];
+            for (unsigned int i = 0; i < t; i++) {
+                RawFr::Element *m = &M[i*t];
+                F.mul(mixed[i], m[0], ls[0]);
+                for (unsigned int j = 1; j < t; j++) {
+                    F.mul(prod, m[j], ls[j]);
+                    F.add(mixed[i], mixed[i], prod);
+                }
+            }
+            for (unsigned int i = 0; i < t; i++) F.copy(ls[i], mixed[i]);
+        }
+    }
+}
+
+void Poseidon::hash(RawFr::Element &r, const RawFr::Element *in) const {
+    RawFr::Element s[POSEIDON_MAX_INPUTS+1];
+    F.copy(s[0], F.zero());
+    for (unsigned int i = 1; i < t; i++) s[i] = in[i-1];
+    permute<1>(s);
+    F.copy(r, s[0]);
+}
+
+void Poseidon::hashRange(RawFr::Element *r, const RawFr::Element *in, uint64_t count) const {
+    RawFr::Element s[POSEIDON_LANES*(POSEIDON_MAX_INPUTS+1)];
+    const unsigned int n = t - 1;
+    uint64_t h = 0;
+    for (; h + POSEIDON_LANES <= count; h += POSEIDON_LANES) {
+        for (unsigned int l = 0; l < POSEIDON_LANES; l++) {
+            F.copy(s[l*t], F.zero());
+            for (unsigned int i = 0; i < n; i++) s[l*t + 1 + i] = in[(h + l)*n + i];
+        }
+        permute<POSEIDON_LANES>(s);
+        for (unsigned int l = 0; l < POSEIDON_LANES; l++) F.copy(r[h + l], s[l*t]);
+    }
+    for (; h < count; h++) hash(r[h], &in[h*n]);
+}
+
+void Poseidon::hashBatch(RawFr::Element *r, const RawFr::Element *in, uint64_t count, unsigned int nThreads) const {
+    if (nThreads > count / POSEIDON_LANES) nThreads = count / POSEIDON_LANES;
+    if (nThreads <= 1) {
+        hashRange(r, in, count);
+        return;
+    }
+    // Ranges of whole lane groups, the last thread takes the rest
+    uint64_t perThread = (count / nThreads) / POSEIDON_LANES * POSEIDON_LANES;
+    const unsigned int n = t - 1;
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < nThreads; i++) {
+        uint64_t start = i*perThread;
+        uint64_t size = i == nThreads-1 ? count - start : perThread;
+        threads.push_back(std::thread(&Poseidon::hashRange, this, &r[start], &in[start*n], size));
+    }
+    for (auto &th : threads) th.join();
+}
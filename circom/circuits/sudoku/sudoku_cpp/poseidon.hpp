@@ -0,0 +1,60 @@
+#ifndef POSEIDON_H
+#define POSEIDON_H
+
+#include <vector>
+
+#include "fr.hpp"
+
+/*
+Poseidon hash of circomlib (circuits/poseidon.circom) over the BN254 scalar
+field: state width t = nInputs + 1, 8 full rounds, the partial rounds of
+circomlib for t, x^5 S-box, and the state starts as [0, inputs...] with the
+hash in state[0].
+
+The round constants and the MDS matrix are generated with the Grain LFSR of
+the Poseidon reference scripts on the first use of a width, so they are the
+ones circomlib ships, and kept in Montgomery form as RawFr elements.
+
+hashBatch runs POSEIDON_LANES hashes side by side, each step of a round
+goes over all the lanes before the next one, so the multiplications of
+different lanes do not wait on each other.
+*/
+
+#define POSEIDON_MAX_INPUTS 16
+#define POSEIDON_LANES 4
+
+class Poseidon {
+
+public:
+
+    // The instance for nInputs, 1 to POSEIDON_MAX_INPUTS
+    static const Poseidon &get(unsigned int nInputs);
+
+    unsigned int nInputs() const { return t - 1; }
+
+    // r = Poseidon(in[0], ..., in[nInputs-1])
+    void hash(RawFr::Element &r, const RawFr::Element *in) const;
+
+    // count hashes, in holds nInputs elements per hash. Threads split the
+    // hashes in contiguous ranges.
+    void hashBatch(RawFr::Element *r, const RawFr::Element *in, uint64_t count, unsigned int nThreads = 1) const;
+
+private:
+
+    unsigned int t;
+    unsigned int nRoundsF;
+    unsigned int nRoundsP;
+    // (nRoundsF + nRoundsP)*t round constants and the t*t row major MDS,
+    // mutable as RawFr takes its operands by non const reference
+    mutable std::vector<RawFr::Element> C;
+    mutable std::vector<RawFr::Element> M;
+
+    Poseidon(unsigned int nInputs);
+
+    template <unsigned int LANES>
+    void permute(RawFr::Element *s) const;
+
+    void hashRange(RawFr::Element *r, const RawFr::Element *in, uint64_t count) const;
+};
+
+#endif // POSEIDON_H
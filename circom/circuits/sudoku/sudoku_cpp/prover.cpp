@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+#include "groth16.hpp"
+
+/*
+Native replacement of "snarkjs groth16 prove": reads the proving key and a
+witness, writes proof.json and public.json. --bench proves the witness the
+given number of times and prints the time of every phase. --cache loads the
+key from a cache file written from the .zkey on the first run.
+
+    prover <circuit.zkey> <witness.wtns> <proof.json> <public.json> [--threads <n>] [--bench <iterations>] [--cache <file>]
+*/
+
+static double since(std::chrono::high_resolution_clock::time_point start) {
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end-start).count();
+}
+
+static void writeFile(const std::string &fileName, const std::string &content) {
+  std::ofstream f(fileName);
+  f << content;
+  if (!f) throw std::runtime_error("cannot write " + fileName);
+}
+
+int main(int argc, char *argv[]) {
+  std::string cl(argv[0]);
+  uint nThreads = std::thread::hardware_concurrency();
+  if (nThreads == 0) nThreads = 1;
+  uint benchIterations = 0;
+  std::string cacheFileName;
+  bool badArgs = argc < 5;
+  for (int i = 5; i < argc; i++) {
+    std::string opt(argv[i]);
+    if (opt == "--threads" && i+1 < argc) {
+      nThreads = atoi(argv[++i]);
+    } else if (opt == "--bench" && i+1 < argc) {
+      benchIterations = atoi(argv[++i]);
+    } else if (opt == "--cache" && i+1 < argc) {
+      cacheFileName = argv[++i];
+    } else {
+      badArgs = true;
+    }
+  }
+  if (badArgs) {
+    std::cout << "Usage: " << cl << " <circuit.zkey> <witness.wtns> <proof.json> <public.json> [--threads <n>] [--bench <iterations>] [--cache <file>]\n";
+    return EXIT_FAILURE;
+  }
+
+  try {
+    auto t_start = std::chrono::high_resolution_clock::now();
+    Groth16_ZKey zkey;
+    if (cacheFileName.empty()) {
+      Groth16_readZKey(argv[1], zkey);
+    } else {
+      Groth16_readZKeyCached(argv[1], cacheFileName, zkey);
+    }
+    double loadKey = since(t_start);
+
+    t_start = std::chrono::high_resolution_clock::now();
+    std::vector<uint64_t> witness;
+    Groth16_readWtns(argv[2], witness);
+    if (witness.size() != (uint64_t)zkey.nVars*Fr_N64) {
+      std::cerr << argv[2] << ": " << witness.size()/Fr_N64 << " signals, the key expects " << zkey.nVars << std::endl;
+      return EXIT_FAILURE;
+    }
+    double loadWitness = since(t_start);
+
+    Groth16_Proof proof;
+    Groth16_Timings timings;
+    t_start = std::chrono::high_resolution_clock::now();
+    Groth16_prove(zkey, &witness[0], proof, nThreads, &timings);
+    double prove = since(t_start);
+
+    writeFile(argv[3], Groth16_proofJson(proof));
+    writeFile(argv[4], Groth16_publicJson(zkey, &witness[0]));
+
+    if (benchIterations > 0) {
+      Groth16_Timings total = {0, 0, 0};
+      double proveTotal = 0, proveMin = 0;
+      for (uint i = 0; i < benchIterations; i++) {
+        t_start = std::chrono::high_resolution_clock::now();
+        Groth16_prove(zkey, &witness[0], proof, nThreads, &timings);
+        double t = since(t_start);
+        proveTotal += t;
+        if (i == 0 || t < proveMin) proveMin = t;
+        total.abc += timings.abc;
+        total.fft += timings.fft;
+        total.msm += timings.msm;
+      }
+      std::cout << std::fixed << std::setprecision(3);
+      std::cout << "signals: " << zkey.nVars << ", constraints domain: " << zkey.domainSize
+                << ", threads: " << nThreads << ", iterations: " << benchIterations << std::endl;
+      std::cout << "load zkey:    " << loadKey << " ms" << std::endl;
+      std::cout << "load witness: " << loadWitness << " ms" << std::endl;
+      std::cout << "prove:        avg " << proveTotal/benchIterations << " ms, min " << proveMin << " ms" << std::endl;
+      std::cout << "  A, B, C:    avg " << total.abc/benchIterations << " ms" << std::endl;
+      std::cout << "  FFT, h:     avg " << total.fft/benchIterations << " ms" << std::endl;
+      std::cout << "  MSM:        avg " << total.msm/benchIterations << " ms" << std::endl;
+    } else {
+      std::cout << std::fixed << std::setprecision(3);
+      std::cout << "load zkey " << loadKey << " ms, load witness " << loadWitness << " ms, prove " << prove << " ms" << std::endl;
+    }
+  } catch (std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return 0;
+}
@@ -1,1375 +0,0 @@
-#include <stdio.h>
-#include <iostream>
-#include <assert.h>
-#include "circom.hpp"
-#include "calcwit.hpp"
-void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void Num2Bits_0_run(uint ctx_index,Circom_CalcWit* ctx);
-void LessThan_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void LessThan_1_run(uint ctx_index,Circom_CalcWit* ctx);
-void LessEqThan_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void LessEqThan_2_run(uint ctx_index,Circom_CalcWit* ctx);
-void GreaterEqThan_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void GreaterEqThan_3_run(uint ctx_index,Circom_CalcWit* ctx);
-void IsZero_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void IsZero_4_run(uint ctx_index,Circom_CalcWit* ctx);
-void IsEqual_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void IsEqual_5_run(uint ctx_index,Circom_CalcWit* ctx);
-void NumberVerifier_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void NumberVerifier_6_run(uint ctx_index,Circom_CalcWit* ctx);
-void SudokuNumberVerifier_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void SudokuNumberVerifier_7_run(uint ctx_index,Circom_CalcWit* ctx);
-void SubgroupVerifier_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void SubgroupVerifier_8_run(uint ctx_index,Circom_CalcWit* ctx);
-void Sudoku_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather);
-void Sudoku_9_run(uint ctx_index,Circom_CalcWit* ctx);
-Circom_TemplateFunction _functionTable[10] = { 
-Num2Bits_0_run,
-LessThan_1_run,
-LessEqThan_2_run,
-GreaterEqThan_3_run,
-IsZero_4_run,
-IsEqual_5_run,
-NumberVerifier_6_run,
-SudokuNumberVerifier_7_run,
-SubgroupVerifier_8_run,
-Sudoku_9_run };
-uint get_main_input_signal_start() {return 2;}
-
-uint get_main_input_signal_no() {return 162;}
-
-uint get_total_signal_no() {return 31458;}
-
-uint get_number_of_components() {return 3674;}
-
-uint get_size_of_input_hashmap() {return 256;}
-
-uint get_size_of_witness() {return 21386;}
-
-uint get_size_of_constants() {return 8;}
-
-uint get_size_of_io_map() {return 0;}
-
-// function declarations
-// template declarations
-void Num2Bits_0_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 0;
-ctx->componentMemory[coffset].templateName = "Num2Bits";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
-}
-
-void Num2Bits_0_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[6];
-FrElement lvar[4];
-uint sub_component_aux;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[0]);
-}
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[2]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[0]); // line circom 31
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)];
-// load src
-Fr_shr(&expaux[1],&signalValues[mySignalStart + 33],&lvar[3]); // line circom 32
-Fr_band(&expaux[0],&expaux[1],&circuitConstants[2]); // line circom 32
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_sub(&expaux[3],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&circuitConstants[2]); // line circom 33
-Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&expaux[3]); // line circom 33
-Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-Fr_mul(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&lvar[2]); // line circom 34
-Fr_add(&expaux[0],&lvar[1],&expaux[2]); // line circom 34
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&lvar[2]); // line circom 35
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 31
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[0]); // line circom 31
-}
-Fr_eq(&expaux[0],&lvar[1],&signalValues[mySignalStart + 33]); // line circom 38
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 38. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-}
-
-void LessThan_1_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 1;
-ctx->componentMemory[coffset].templateName = "LessThan";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[1];
-}
-
-void LessThan_1_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[4];
-FrElement lvar[1];
-uint sub_component_aux;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[3]);
-}
-{
-uint aux_create = 0;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+3;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "n2b";
-mySubcomponents[aux_create+i] = aux_cmp_num;
-Num2Bits_0_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 34 ;
-aux_cmp_num += 1;
-}
-}
-if (!Fr_isTrue(&circuitConstants[2])) std::cout << "Failed assert in template/function " << myTemplateName << " line 90. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&circuitConstants[2]));
-{
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 33];
-// load src
-Fr_add(&expaux[1],&signalValues[mySignalStart + 1],&circuitConstants[4]); // line circom 96
-Fr_sub(&expaux[0],&expaux[1],&signalValues[mySignalStart + 2]); // line circom 96
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-// need to run sub component
-assert(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-Num2Bits_0_run(mySubcomponents[cmp_index_ref],ctx);
-}
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
-// load src
-Fr_sub(&expaux[0],&circuitConstants[2],&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 32]); // line circom 98
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-}
-
-void LessEqThan_2_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 2;
-ctx->componentMemory[coffset].templateName = "LessEqThan";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[1];
-}
-
-void LessEqThan_2_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[3];
-FrElement lvar[1];
-uint sub_component_aux;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[3]);
-}
-{
-uint aux_create = 0;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+3;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "lt";
-mySubcomponents[aux_create+i] = aux_cmp_num;
-LessThan_1_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 37 ;
-aux_cmp_num += 2;
-}
-}
-{
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + 1]);
-}
-// no need to run sub component
-assert(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter);
-}
-{
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 2];
-// load src
-Fr_add(&expaux[0],&signalValues[mySignalStart + 2],&circuitConstants[2]); // line circom 112
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-// need to run sub component
-assert(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-LessThan_1_run(mySubcomponents[cmp_index_ref],ctx);
-}
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
-// load src
-// end load src
-Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 0]);
-}
-}
-
-void GreaterEqThan_3_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 3;
-ctx->componentMemory[coffset].templateName = "GreaterEqThan";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[1];
-}
-
-void GreaterEqThan_3_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[3];
-FrElement lvar[1];
-uint sub_component_aux;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[3]);
-}
-{
-uint aux_create = 0;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+3;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "lt";
-mySubcomponents[aux_create+i] = aux_cmp_num;
-LessThan_1_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 37 ;
-aux_cmp_num += 2;
-}
-}
-{
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + 2]);
-}
-// no need to run sub component
-assert(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter);
-}
-{
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 2];
-// load src
-Fr_add(&expaux[0],&signalValues[mySignalStart + 1],&circuitConstants[2]); // line circom 138
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-// need to run sub component
-assert(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-LessThan_1_run(mySubcomponents[cmp_index_ref],ctx);
-}
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
-// load src
-// end load src
-Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 0]);
-}
-}
-
-void IsZero_4_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 4;
-ctx->componentMemory[coffset].templateName = "IsZero";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[0];
-}
-
-void IsZero_4_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[4];
-FrElement lvar[0];
-uint sub_component_aux;
-Fr_neq(&expaux[0],&signalValues[mySignalStart + 1],&circuitConstants[1]); // line circom 30
-if(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 2];
-// load src
-Fr_div(&expaux[0],&circuitConstants[2],&signalValues[mySignalStart + 1]); // line circom 30
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-}else{
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-}
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
-// load src
-Fr_neg(&expaux[2],&signalValues[mySignalStart + 1]); // line circom 32
-Fr_mul(&expaux[1],&expaux[2],&signalValues[mySignalStart + 2]); // line circom 32
-Fr_add(&expaux[0],&expaux[1],&circuitConstants[2]); // line circom 32
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_mul(&expaux[1],&signalValues[mySignalStart + 1],&signalValues[mySignalStart + 0]); // line circom 33
-Fr_eq(&expaux[0],&expaux[1],&circuitConstants[1]); // line circom 33
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 33. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-}
-
-void IsEqual_5_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 5;
-ctx->componentMemory[coffset].templateName = "IsEqual";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 2;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[1];
-}
-
-void IsEqual_5_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[3];
-FrElement lvar[0];
-uint sub_component_aux;
-{
-uint aux_create = 0;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+3;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "isz";
-mySubcomponents[aux_create+i] = aux_cmp_num;
-IsZero_4_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 3 ;
-aux_cmp_num += 1;
-}
-}
-{
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-Fr_sub(&expaux[0],&signalValues[mySignalStart + 2],&signalValues[mySignalStart + 1]); // line circom 43
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-// need to run sub component
-assert(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-IsZero_4_run(mySubcomponents[cmp_index_ref],ctx);
-}
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
-// load src
-// end load src
-Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 0]);
-}
-}
-
-void NumberVerifier_6_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 6;
-ctx->componentMemory[coffset].templateName = "NumberVerifier";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 1;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[3];
-}
-
-void NumberVerifier_6_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[2];
-FrElement lvar[1];
-uint sub_component_aux;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[5]);
-}
-{
-uint aux_create = 0;
-int aux_cmp_num = 2+ctx_index+1;
-uint csoffset = mySignalStart+8;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "greq1";
-mySubcomponents[aux_create+i] = aux_cmp_num;
-GreaterEqThan_3_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 40 ;
-aux_cmp_num += 3;
-}
-}
-{
-uint aux_create = 1;
-int aux_cmp_num = 5+ctx_index+1;
-uint csoffset = mySignalStart+48;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "leqN";
-mySubcomponents[aux_create+i] = aux_cmp_num;
-LessEqThan_2_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 40 ;
-aux_cmp_num += 3;
-}
-}
-{
-uint aux_create = 2;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+2;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "equal";
-mySubcomponents[aux_create+i] = aux_cmp_num;
-IsEqual_5_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 6 ;
-aux_cmp_num += 2;
-}
-}
-{
-uint cmp_index_ref = 1;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + 1]);
-}
-// no need to run sub component
-assert(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter);
-}
-{
-uint cmp_index_ref = 1;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[5]);
-}
-// need to run sub component
-assert(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-LessEqThan_2_run(mySubcomponents[cmp_index_ref],ctx);
-}
-{
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + 1]);
-}
-// no need to run sub component
-assert(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter);
-}
-{
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[2]);
-}
-// need to run sub component
-assert(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-GreaterEqThan_3_run(mySubcomponents[cmp_index_ref],ctx);
-}
-{
-uint cmp_index_ref = 2;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[1]].signalStart + 0]);
-}
-// no need to run sub component
-assert(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter);
-}
-{
-uint cmp_index_ref = 2;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 2];
-// load src
-// end load src
-Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 0]);
-}
-// need to run sub component
-assert(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter));
-IsEqual_5_run(mySubcomponents[cmp_index_ref],ctx);
-}
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
-// load src
-// end load src
-Fr_copy(aux_dest,&ctx->signalValues[ctx->componentMemory[mySubcomponents[2]].signalStart + 0]);
-}
-}
-
-void SudokuNumberVerifier_7_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 7;
-ctx->componentMemory[coffset].templateName = "SudokuNumberVerifier";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 81;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[81];
-}
-
-void SudokuNumberVerifier_7_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[3];
-FrElement lvar[2];
-uint sub_component_aux;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[5]);
-}
-{
-uint aux_create = 0;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+82;
-uint aux_dimensions[1] = {81};
-for (uint i = 0; i < 81; i++) {
-std::string new_cmp_name = "numberVerifiers"+ctx->generate_position_array(aux_dimensions, 1, i);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-NumberVerifier_6_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 88 ;
-aux_cmp_num += 9;
-}
-}
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[1],&circuitConstants[6]); // line circom 152
-while(Fr_isTrue(&expaux[0])){
-{
-uint cmp_index_ref = ((1 * Fr_toInt(&lvar[1])) + 0);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[1])) + 1)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-NumberVerifier_6_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * Fr_toInt(&lvar[1])) + 0)]].signalStart + 0],&circuitConstants[2]); // line circom 155
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 155. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-Fr_add(&expaux[0],&lvar[1],&circuitConstants[2]); // line circom 152
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[1],&circuitConstants[6]); // line circom 152
-}
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[2]);
-}
-}
-
-void SubgroupVerifier_8_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 8;
-ctx->componentMemory[coffset].templateName = "SubgroupVerifier";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 9;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[18];
-}
-
-void SubgroupVerifier_8_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[4];
-FrElement lvar[11];
-uint sub_component_aux;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[5]);
-}
-{
-uint aux_create = 0;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+19;
-uint aux_dimensions[1] = {9};
-for (uint i = 0; i < 9; i++) {
-std::string new_cmp_name = "numberVerifier"+ctx->generate_position_array(aux_dimensions, 1, i);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-NumberVerifier_6_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 88 ;
-aux_cmp_num += 9;
-}
-}
-{
-uint aux_create = 9;
-int aux_cmp_num = 81+ctx_index+1;
-uint csoffset = mySignalStart+811;
-uint aux_dimensions[1] = {9};
-for (uint i = 0; i < 9; i++) {
-std::string new_cmp_name = "zeroCheckers"+ctx->generate_position_array(aux_dimensions, 1, i);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-IsEqual_5_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 6 ;
-aux_cmp_num += 2;
-}
-}
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[1],&circuitConstants[5]); // line circom 89
-while(Fr_isTrue(&expaux[0])){
-{
-uint cmp_index_ref = ((1 * Fr_toInt(&lvar[1])) + 0);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[1])) + 1)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-NumberVerifier_6_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * Fr_toInt(&lvar[1])) + 0)]].signalStart + 0],&circuitConstants[2]); // line circom 92
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 92. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-Fr_add(&expaux[0],&lvar[1],&circuitConstants[2]); // line circom 89
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[1],&circuitConstants[5]); // line circom 89
-}
-{
-PFrElement aux_dest = &lvar[10];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[10],&circuitConstants[5]); // line circom 97
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &lvar[((1 * Fr_toInt(&lvar[10])) + 1)];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-{
-PFrElement aux_dest = &lvar[10];
-// load src
-Fr_add(&expaux[0],&lvar[10],&circuitConstants[2]); // line circom 97
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[10],&circuitConstants[5]); // line circom 97
-}
-{
-PFrElement aux_dest = &lvar[10];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[10],&circuitConstants[5]); // line circom 102
-while(Fr_isTrue(&expaux[0])){
-Fr_sub(&expaux[0],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[10])) + 1)],&circuitConstants[2]); // line circom 103
-{
-PFrElement aux_dest = &lvar[((1 * Fr_toInt(&expaux[0])) + 1)];
-// load src
-Fr_sub(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[10])) + 1)],&circuitConstants[2]); // line circom 103
-Fr_add(&expaux[0],&lvar[((1 * Fr_toInt(&expaux[1])) + 1)],&circuitConstants[2]); // line circom 103
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[10];
-// load src
-Fr_add(&expaux[0],&lvar[10],&circuitConstants[2]); // line circom 102
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[10],&circuitConstants[5]); // line circom 102
-}
-{
-PFrElement aux_dest = &lvar[10];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[10],&circuitConstants[5]); // line circom 110
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[10])) + 10)];
-// load src
-// end load src
-Fr_copy(aux_dest,&lvar[((1 * Fr_toInt(&lvar[10])) + 1)]);
-}
-{
-uint cmp_index_ref = ((1 * Fr_toInt(&lvar[10])) + 9);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[10])) + 10)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-IsEqual_5_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-uint cmp_index_ref = ((1 * Fr_toInt(&lvar[10])) + 9);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[2]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-IsEqual_5_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * Fr_toInt(&lvar[10])) + 9)]].signalStart + 0],&circuitConstants[2]); // line circom 115
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 115. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[10];
-// load src
-Fr_add(&expaux[0],&lvar[10],&circuitConstants[2]); // line circom 110
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[10],&circuitConstants[5]); // line circom 110
-}
-{
-PFrElement aux_dest = &signalValues[mySignalStart + 0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[2]);
-}
-}
-
-void Sudoku_9_create(uint soffset,uint coffset,Circom_CalcWit* ctx,std::string componentName,uint componentFather){
-ctx->componentMemory[coffset].templateId = 9;
-ctx->componentMemory[coffset].templateName = "Sudoku";
-ctx->componentMemory[coffset].signalStart = soffset;
-ctx->componentMemory[coffset].inputCounter = 162;
-ctx->componentMemory[coffset].componentName = componentName;
-ctx->componentMemory[coffset].idFather = componentFather;
-ctx->componentMemory[coffset].subcomponents = new uint[190];
-}
-
-void Sudoku_9_run(uint ctx_index,Circom_CalcWit* ctx){
-FrElement* signalValues = ctx->signalValues;
-u64 mySignalStart = ctx->componentMemory[ctx_index].signalStart;
-std::string myTemplateName = ctx->componentMemory[ctx_index].templateName;
-std::string myComponentName = ctx->componentMemory[ctx_index].componentName;
-u64 myFather = ctx->componentMemory[ctx_index].idFather;
-u64 myId = ctx_index;
-u32* mySubcomponents = ctx->componentMemory[ctx_index].subcomponents;
-FrElement* circuitConstants = ctx->circuitConstants;
-std::string* listOfTemplateMessages = ctx->listOfTemplateMessages;
-FrElement expaux[6];
-FrElement lvar[12];
-uint sub_component_aux;
-{
-PFrElement aux_dest = &lvar[0];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[5]);
-}
-{
-PFrElement aux_dest = &lvar[1];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[7]);
-}
-{
-uint aux_create = 0;
-int aux_cmp_num = 2043+ctx_index+1;
-uint csoffset = mySignalStart+16462;
-for (uint i = 0; i < 1; i++) {
-std::string new_cmp_name = "numbersVerifier";
-mySubcomponents[aux_create+i] = aux_cmp_num;
-SudokuNumberVerifier_7_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 7210 ;
-aux_cmp_num += 730;
-}
-}
-{
-uint aux_create = 1;
-int aux_cmp_num = 2773+ctx_index+1;
-uint csoffset = mySignalStart+23672;
-uint aux_dimensions[1] = {9};
-for (uint i = 0; i < 9; i++) {
-std::string new_cmp_name = "rowVerifiers"+ctx->generate_position_array(aux_dimensions, 1, i);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-SubgroupVerifier_8_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 865 ;
-aux_cmp_num += 100;
-}
-}
-{
-uint aux_create = 10;
-int aux_cmp_num = 900+ctx_index+1;
-uint csoffset = mySignalStart+7948;
-uint aux_dimensions[1] = {9};
-for (uint i = 0; i < 9; i++) {
-std::string new_cmp_name = "columnVerifiers"+ctx->generate_position_array(aux_dimensions, 1, i);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-SubgroupVerifier_8_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 865 ;
-aux_cmp_num += 100;
-}
-}
-{
-uint aux_create = 19;
-int aux_cmp_num = 0+ctx_index+1;
-uint csoffset = mySignalStart+163;
-uint aux_dimensions[1] = {9};
-for (uint i = 0; i < 9; i++) {
-std::string new_cmp_name = "boxVerifiers"+ctx->generate_position_array(aux_dimensions, 1, i);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-SubgroupVerifier_8_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 865 ;
-aux_cmp_num += 100;
-}
-}
-{
-uint aux_create = 28;
-int aux_cmp_num = 1800+ctx_index+1;
-uint csoffset = mySignalStart+15733;
-uint aux_dimensions[2] = {9,9};
-for (uint i = 0; i < 81; i++) {
-std::string new_cmp_name = "isEquals"+ctx->generate_position_array(aux_dimensions, 2, i);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-IsEqual_5_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 6 ;
-aux_cmp_num += 2;
-}
-}
-{
-uint aux_create = 109;
-int aux_cmp_num = 1962+ctx_index+1;
-uint csoffset = mySignalStart+16219;
-uint aux_dimensions[2] = {9,9};
-for (uint i = 0; i < 81; i++) {
-std::string new_cmp_name = "isZeros"+ctx->generate_position_array(aux_dimensions, 2, i);
-mySubcomponents[aux_create+i] = aux_cmp_num;
-IsZero_4_create(csoffset,aux_cmp_num,ctx,new_cmp_name,myId);
-csoffset += 3 ;
-aux_cmp_num += 1;
-}
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[5]); // line circom 11
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[5]); // line circom 12
-while(Fr_isTrue(&expaux[0])){
-{
-uint cmp_index_ref = 0;
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + ((1 * ((Fr_toInt(&lvar[2]) * 9) + Fr_toInt(&lvar[3]))) + 1)];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + (((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 82)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-SudokuNumberVerifier_7_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 12
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[5]); // line circom 12
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&circuitConstants[2]); // line circom 11
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[5]); // line circom 11
-}
-Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[0]].signalStart + 0],&circuitConstants[2]); // line circom 16
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 16. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[5]); // line circom 21
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[5]); // line circom 23
-while(Fr_isTrue(&expaux[0])){
-{
-uint cmp_index_ref = ((1 * Fr_toInt(&lvar[2])) + 1);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 1)];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + (((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 82)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-SubgroupVerifier_8_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 23
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[5]); // line circom 23
-}
-Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * Fr_toInt(&lvar[2])) + 1)]].signalStart + 0],&circuitConstants[2]); // line circom 26
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 26. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&circuitConstants[2]); // line circom 21
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[5]); // line circom 21
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[5]); // line circom 31
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[5]); // line circom 33
-while(Fr_isTrue(&expaux[0])){
-{
-uint cmp_index_ref = ((1 * Fr_toInt(&lvar[2])) + 10);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + ((1 * Fr_toInt(&lvar[3])) + 1)];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + (((9 * Fr_toInt(&lvar[3])) + (1 * Fr_toInt(&lvar[2]))) + 82)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-SubgroupVerifier_8_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 33
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[5]); // line circom 33
-}
-Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * Fr_toInt(&lvar[2])) + 10)]].signalStart + 0],&circuitConstants[2]); // line circom 36
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 36. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&circuitConstants[2]); // line circom 31
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[5]); // line circom 31
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[7]); // line circom 43
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[7]); // line circom 44
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &lvar[4];
-// load src
-Fr_mul(&expaux[0],&lvar[2],&circuitConstants[7]); // line circom 45
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[5];
-// load src
-Fr_mul(&expaux[0],&lvar[3],&circuitConstants[7]); // line circom 46
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[6];
-// load src
-Fr_mul(&expaux[1],&lvar[2],&circuitConstants[7]); // line circom 49
-Fr_add(&expaux[0],&expaux[1],&lvar[3]); // line circom 49
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[7];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[7],&circuitConstants[7]); // line circom 51
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &lvar[8];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[8],&circuitConstants[7]); // line circom 52
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &lvar[9];
-// load src
-Fr_add(&expaux[0],&lvar[4],&lvar[7]); // line circom 53
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[10];
-// load src
-Fr_add(&expaux[0],&lvar[5],&lvar[8]); // line circom 54
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-PFrElement aux_dest = &lvar[11];
-// load src
-Fr_mul(&expaux[1],&lvar[7],&circuitConstants[7]); // line circom 55
-Fr_add(&expaux[0],&expaux[1],&lvar[8]); // line circom 55
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-{
-uint cmp_index_ref = ((1 * Fr_toInt(&lvar[6])) + 19);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + ((1 * Fr_toInt(&lvar[11])) + 1)];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + (((9 * Fr_toInt(&lvar[9])) + (1 * Fr_toInt(&lvar[10]))) + 82)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-SubgroupVerifier_8_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-PFrElement aux_dest = &lvar[8];
-// load src
-Fr_add(&expaux[0],&lvar[8],&circuitConstants[2]); // line circom 52
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[8],&circuitConstants[7]); // line circom 52
-}
-{
-PFrElement aux_dest = &lvar[7];
-// load src
-Fr_add(&expaux[0],&lvar[7],&circuitConstants[2]); // line circom 51
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[7],&circuitConstants[7]); // line circom 51
-}
-Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[((1 * Fr_toInt(&lvar[6])) + 19)]].signalStart + 0],&circuitConstants[2]); // line circom 60
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 60. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 44
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[7]); // line circom 44
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&circuitConstants[2]); // line circom 43
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[7]); // line circom 43
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[5]); // line circom 68
-while(Fr_isTrue(&expaux[0])){
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-// end load src
-Fr_copy(aux_dest,&circuitConstants[1]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[5]); // line circom 69
-while(Fr_isTrue(&expaux[0])){
-{
-uint cmp_index_ref = (((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 28);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + (((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 82)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-IsEqual_5_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-uint cmp_index_ref = (((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 28);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 2];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + (((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 1)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-IsEqual_5_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-{
-uint cmp_index_ref = (((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 109);
-{
-PFrElement aux_dest = &ctx->signalValues[ctx->componentMemory[mySubcomponents[cmp_index_ref]].signalStart + 1];
-// load src
-// end load src
-Fr_copy(aux_dest,&signalValues[mySignalStart + (((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 1)]);
-}
-// run sub component if needed
-if(!(--ctx->componentMemory[mySubcomponents[cmp_index_ref]].inputCounter)){
-IsZero_4_run(mySubcomponents[cmp_index_ref],ctx);
-
-}
-}
-Fr_sub(&expaux[2],&circuitConstants[2],&ctx->signalValues[ctx->componentMemory[mySubcomponents[(((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 109)]].signalStart + 0]); // line circom 77
-Fr_eq(&expaux[0],&ctx->signalValues[ctx->componentMemory[mySubcomponents[(((9 * Fr_toInt(&lvar[2])) + (1 * Fr_toInt(&lvar[3]))) + 28)]].signalStart + 0],&expaux[2]); // line circom 77
-if (!Fr_isTrue(&expaux[0])) std::cout << "Failed assert in template/function " << myTemplateName << " line 77. " <<  "Followed trace of components: " << ctx->getTrace(myId) << std::endl;
-assert(Fr_isTrue(&expaux[0]));
-{
-PFrElement aux_dest = &lvar[3];
-// load src
-Fr_add(&expaux[0],&lvar[3],&circuitConstants[2]); // line circom 69
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[3],&circuitConstants[5]); // line circom 69
-}
-{
-PFrElement aux_dest = &lvar[2];
-// load src
-Fr_add(&expaux[0],&lvar[2],&circuitConstants[2]); // line circom 68
-// end load src
-Fr_copy(aux_dest,&expaux[0]);
-}
-Fr_lt(&expaux[0],&lvar[2],&circuitConstants[5]); // line circom 68
-}
-}
-
-void run(Circom_CalcWit* ctx){
-Sudoku_9_create(1,0,ctx,"main",0);
-Sudoku_9_run(0,ctx);
-}
-
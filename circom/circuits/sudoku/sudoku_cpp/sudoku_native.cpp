@@ -0,0 +1,570 @@
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "sudoku_native.hpp"
+
+/*
+Signal offsets of each template, relative to its signalStart. circom lays a
+component out as its outputs, inputs and intermediate signals in the order
+they are declared, then its subcomponents sorted by name.
+sudoku_native_circuit checks these offsets against the tables of the
+generated code before the engine is used.
+*/
+
+// IsZero: out, in, inv
+// IsEqual: out, in[2], isz
+#define ISZERO_SIZE 3
+#define ISEQUAL_ISZ 3
+#define ISEQUAL_SIZE 6
+
+// NumberVerifier(N): out, in, check
+#define NV_CHECK 2
+
+// BitsRangeCheck(N): in, high, low
+#define BRC_HIGH 1
+
+#define MAIN_START 1
+
+// Largest board the run time size path handles, the group checks keep one
+// bit per number in a u64
+#define NATIVE_MAX_SQRTN 7
+
+// nbits of circomlib, the bits of a
+static inline uint nbits(uint a) {
+  uint r = 0;
+  while ((((u64)1) << r) - 1 < a) r++;
+  return r;
+}
+
+/*
+Offsets of the templates that depend on the board size. With SQRTN != 0
+they are compile time constants, with SQRTN == 0 they are computed from the
+sqrtN given at run time.
+*/
+template <uint SQRTN>
+struct NativeSudokuLayout {
+  uint runtimeSqrtN;
+
+  NativeSudokuLayout(uint sqrtN) : runtimeSqrtN(sqrtN) {}
+
+  inline uint sqrtN() const { return SQRTN ? SQRTN : runtimeSqrtN; }
+  inline uint n() const { return sqrtN()*sqrtN(); }
+
+  // NumberVerifier(N) checks with ProductRangeCheck(N): in, prod[N] when
+  // N - 1 <= 2*(nbits(N - 1) + 1), else with BitsRangeCheck(N), whose high and
+  // low are Num2Bits(nbits(N - 1)): out[nbits(N - 1)], in
+  inline uint rangeBits() const { return nbits(n() - 1); }
+  inline bool productRange() const { return n() - 1 <= 2*(rangeBits() + 1); }
+  inline u64 brcLow() const { return BRC_HIGH + rangeBits() + 1; }
+  inline u64 rangeCheckSize() const { return productRange() ? 1 + n() : brcLow() + rangeBits() + 1; }
+  inline u64 nvSize() const { return NV_CHECK + rangeCheckSize(); }
+
+  // SudokuNumberVerifier(N): out, in[N*N], numberVerifiers[N*N]
+  inline u64 snvNv() const { return 1 + n()*n(); }
+  inline u64 snvSize() const { return snvNv() + n()*n()*nvSize(); }
+
+  // DistinctPermutation(N): in[N], inv[N*(N-1)/2]
+  inline u64 pairs() const { return (u64)n()*(n() - 1)/2; }
+  inline u64 dpSize() const { return n() + pairs(); }
+
+  // SubgroupVerifier(N): out, in[N], check
+  inline u64 sgCheck() const { return 1 + n(); }
+  inline u64 sgSize() const { return sgCheck() + dpSize(); }
+
+  // Sudoku(sqrtN, N): out, unsolved[N][N], solved[N][N], then the subcomponents
+  inline u64 unsolved() const { return 1; }
+  inline u64 solved() const { return 1 + n()*n(); }
+  inline u64 boxes() const { return 1 + 2*n()*n(); }
+  inline u64 columns() const { return boxes() + n()*sgSize(); }
+  inline u64 isEquals() const { return columns() + n()*sgSize(); }
+  inline u64 isZeros() const { return isEquals() + n()*n()*ISEQUAL_SIZE; }
+  inline u64 numbers() const { return isZeros() + n()*n()*ISZERO_SIZE; }
+  inline u64 rows() const { return numbers() + snvSize(); }
+  inline u64 size() const { return rows() + n()*sgSize(); }
+};
+
+static inline uint subcomponentNo(uint t) {
+  return _templateSubcomponentStart[t+1] - _templateSubcomponentStart[t];
+}
+
+// Template of the c-th subcomponent t creates when it is at offset, -1
+// otherwise
+static int subcomponentAt(int t, uint c, u64 offset) {
+  if (t < 0 || c >= subcomponentNo(t)) return -1;
+  const uint *sub = _templateSubcomponents[_templateSubcomponentStart[t] + c];
+  return sub[1] == offset ? (int)sub[0] : -1;
+}
+
+// Template of the count subcomponents from the c-th on when they are all
+// the same one, every stride signals from offset on, -1 otherwise
+static int subcomponentsAt(int t, uint c, uint count, u64 offset, u64 stride) {
+  int first = subcomponentAt(t, c, offset);
+  for (uint i = 1; i < count && first >= 0; i++) {
+    if (subcomponentAt(t, c + i, offset + i*stride) != first) return -1;
+  }
+  return first;
+}
+
+static bool templateIs(int t, const char *name, u64 size, uint subcomponents) {
+  return t >= 0 && strcmp(_templateNames[t], name) == 0 && _templateSignalNo[t] == size &&
+         subcomponentNo(t) == subcomponents;
+}
+
+// Subcomponents are listed in the order they are created, which is the
+// order of their declarations
+template <uint SQRTN>
+static bool numberVerifierMatches(const NativeSudokuLayout<SQRTN> &l, int t) {
+  if (!templateIs(t, "NumberVerifier", l.nvSize(), 1)) return false;
+  int check = subcomponentAt(t, 0, NV_CHECK);
+  if (l.productRange()) return templateIs(check, "ProductRangeCheck", l.rangeCheckSize(), 0);
+  return templateIs(check, "BitsRangeCheck", l.rangeCheckSize(), 2) &&
+         templateIs(subcomponentAt(check, 0, l.brcLow()), "Num2Bits", l.rangeBits() + 1, 0) &&
+         templateIs(subcomponentAt(check, 1, BRC_HIGH), "Num2Bits", l.rangeBits() + 1, 0);
+}
+
+template <uint SQRTN>
+static bool sudokuMatches(const NativeSudokuLayout<SQRTN> &l, int t) {
+  const uint n = l.n();
+  if (!templateIs(t, "Sudoku", l.size(), 1 + 3*n + 2*n*n)) return false;
+
+  int numbers = subcomponentAt(t, 0, l.numbers());
+  if (!templateIs(numbers, "SudokuNumberVerifier", l.snvSize(), n*n) ||
+      !numberVerifierMatches(l, subcomponentsAt(numbers, 0, n*n, l.snvNv(), l.nvSize()))) {
+    return false;
+  }
+
+  int rows = subcomponentsAt(t, 1, n, l.rows(), l.sgSize());
+  if (!templateIs(rows, "SubgroupVerifier", l.sgSize(), 1) ||
+      !templateIs(subcomponentAt(rows, 0, l.sgCheck()), "DistinctPermutation", l.dpSize(), 0) ||
+      subcomponentsAt(t, 1 + n, n, l.columns(), l.sgSize()) != rows ||
+      subcomponentsAt(t, 1 + 2*n, n, l.boxes(), l.sgSize()) != rows) {
+    return false;
+  }
+
+  int isEquals = subcomponentsAt(t, 1 + 3*n, n*n, l.isEquals(), ISEQUAL_SIZE);
+  int isZeros = subcomponentsAt(t, 1 + 3*n + n*n, n*n, l.isZeros(), ISZERO_SIZE);
+  return templateIs(isEquals, "IsEqual", ISEQUAL_SIZE, 1) &&
+         templateIs(isZeros, "IsZero", ISZERO_SIZE, 0) &&
+         subcomponentAt(isEquals, 0, ISEQUAL_ISZ) == isZeros;
+}
+
+// Montgomery inverses of -MAXN..MAXN, the values IsZero and
+// DistinctPermutation see on the boards compiled for
+#define INVERSES_MAXN 25
+
+struct Circom_NativeInverses {
+  FrElement v[2*INVERSES_MAXN+1];
+  Circom_NativeInverses() {
+    for (int x = -INVERSES_MAXN; x <= INVERSES_MAXN; x++) {
+      Fr_fromValue(&v[x+INVERSES_MAXN], FrValue::fromInt(x).inv());
+    }
+  }
+};
+
+static const Circom_NativeInverses &nativeInverses() {
+  static Circom_NativeInverses inverses;
+  return inverses;
+}
+
+static inline void setInt(Circom_SignalStore &s, u64 i, int64_t v) {
+  if (v >= INT32_MIN && v <= INT32_MAX) {
+    s.setShort(i, (int32_t)v);
+  } else {
+    FrElement e;
+    Fr_fromU64(&e, (uint64_t)v);
+    s.set(i, &e);
+  }
+}
+
+// 1/x, or 0 for x = 0 as the hints of the circuit give it
+static inline void setInverse(Circom_SignalStore &s, u64 i, int x) {
+  if (!x) {
+    s.setShort(i, 0);
+  } else if (x >= -INVERSES_MAXN && x <= INVERSES_MAXN) {
+    FrElement inv = nativeInverses().v[x+INVERSES_MAXN];
+    s.set(i, &inv);
+  } else {
+    FrElement inv;
+    Fr_fromValue(&inv, FrValue::fromInt(x).inv());
+    s.set(i, &inv);
+  }
+}
+
+// Num2Bits(bits) of 0 <= v < 2^bits
+static inline void num2Bits(Circom_SignalStore &s, u64 start, uint bits, int v) {
+  for (uint i = 0; i < bits; i++) {
+    s.setShort(start + i, (v >> i) & 1);
+  }
+  s.setShort(start + bits, v);
+}
+
+// x is in -N..N
+static inline int isZero(Circom_SignalStore &s, u64 start, int x) {
+  setInt(s, start + 1, x);
+  setInverse(s, start + 2, x);
+  int out = x ? 0 : 1;
+  s.setShort(start, out);
+  return out;
+}
+
+static inline int isEqual(Circom_SignalStore &s, u64 start, int a, int b) {
+  setInt(s, start + 1, a);
+  setInt(s, start + 2, b);
+  int out = isZero(s, start + ISEQUAL_ISZ, b - a);
+  s.setShort(start, out);
+  return out;
+}
+
+// x is in 1..N
+template <uint SQRTN>
+static inline void numberVerifier(const NativeSudokuLayout<SQRTN> &l, Circom_SignalStore &s, u64 start, int x) {
+  const int n = l.n();
+  const u64 check = start + NV_CHECK;
+  s.setShort(start + 1, x);
+  s.setShort(check, x);
+  if (l.productRange()) {
+    // prod[i] = (x - 1)...(x - i - 1), at most (N - 1)!
+    int64_t prod = x - 1;
+    setInt(s, check + 1, prod);
+    for (int i = 1; i < n; i++) {
+      prod *= x - i - 1;
+      setInt(s, check + 1 + i, prod);
+    }
+  } else {
+    num2Bits(s, check + BRC_HIGH, l.rangeBits(), n - x);
+    num2Bits(s, check + l.brcLow(), l.rangeBits(), x - 1);
+  }
+  s.setShort(start, 1);
+}
+
+template <uint SQRTN>
+static void sudokuNumberVerifier(const NativeSudokuLayout<SQRTN> &l, Circom_SignalStore &s, u64 start, const int *cells) {
+  const uint n = l.n();
+  for (uint i = 0; i < n*n; i++) {
+    s.setShort(start + 1 + i, cells[i]);
+    numberVerifier(l, s, start + l.snvNv() + i*l.nvSize(), cells[i]);
+  }
+  s.setShort(start, 1);
+}
+
+template <uint SQRTN>
+static void subgroupVerifier(const NativeSudokuLayout<SQRTN> &l, Circom_SignalStore &s, u64 start, const int *in) {
+  const uint n = l.n();
+  const u64 check = start + l.sgCheck();
+  for (uint i = 0; i < n; i++) {
+    s.setShort(start + 1 + i, in[i]);
+    s.setShort(check + i, in[i]);
+  }
+  u64 pair = check + n;
+  for (uint i = 0; i < n; i++) {
+    for (uint j = i + 1; j < n; j++) setInverse(s, pair++, in[i] - in[j]);
+  }
+  s.setShort(start, 1);
+}
+
+// Checks the board is one the circuit accepts and fills the rows, columns
+// and boxes of work, which has room for 3*N*N ints
+template <uint SQRTN>
+static bool validBoard(const NativeSudokuLayout<SQRTN> &l, const int *unsolved, const int *solved, int *work) {
+  const uint sqrtN = l.sqrtN();
+  const uint n = l.n();
+  if (sqrtN < 1 || sqrtN > NATIVE_MAX_SQRTN) return false;
+
+  for (uint i = 0; i < n*n; i++) {
+    if (solved[i] < 1 || solved[i] > (int)n) return false;
+    if (unsolved[i] != 0 && unsolved[i] != solved[i]) return false;
+  }
+
+  int *rows = &work[0];
+  int *columns = &work[n*n];
+  int *boxes = &work[2*n*n];
+  for (uint i = 0; i < n; i++) {
+    for (uint j = 0; j < n; j++) {
+      rows[i*n + j] = solved[i*n + j];
+      columns[j*n + i] = solved[i*n + j];
+      boxes[((i/sqrtN)*sqrtN + j/sqrtN)*n + (i%sqrtN)*sqrtN + j%sqrtN] = solved[i*n + j];
+    }
+  }
+  // Every group must hold each number once
+  const uint64_t all = (((uint64_t)1 << n) - 1) << 1;
+  for (uint i = 0; i < n; i++) {
+    uint64_t rowSeen = 0, columnSeen = 0, boxSeen = 0;
+    for (uint j = 0; j < n; j++) {
+      rowSeen |= (uint64_t)1 << rows[i*n + j];
+      columnSeen |= (uint64_t)1 << columns[i*n + j];
+      boxSeen |= (uint64_t)1 << boxes[i*n + j];
+    }
+    if (rowSeen != all || columnSeen != all || boxSeen != all) return false;
+  }
+  return true;
+}
+
+// Writes a Sudoku component at signal start, work as filled by validBoard
+template <uint SQRTN>
+static void writeBoard(const NativeSudokuLayout<SQRTN> &l, Circom_SignalStore &s, u64 start, const int *unsolved, const int *solved, int *work) {
+  const uint n = l.n();
+  int *rows = &work[0];
+  int *columns = &work[n*n];
+  int *boxes = &work[2*n*n];
+
+  for (uint i = 0; i < n*n; i++) {
+    s.setShort(start + l.unsolved() + i, unsolved[i]);
+    s.setShort(start + l.solved() + i, solved[i]);
+  }
+  sudokuNumberVerifier(l, s, start + l.numbers(), solved);
+  for (uint i = 0; i < n; i++) {
+    subgroupVerifier(l, s, start + l.rows() + i*l.sgSize(), &rows[i*n]);
+    subgroupVerifier(l, s, start + l.columns() + i*l.sgSize(), &columns[i*n]);
+    subgroupVerifier(l, s, start + l.boxes() + i*l.sgSize(), &boxes[i*n]);
+  }
+  for (uint i = 0; i < n*n; i++) {
+    isEqual(s, start + l.isEquals() + i*ISEQUAL_SIZE, solved[i], unsolved[i]);
+    isZero(s, start + l.isZeros() + i*ISZERO_SIZE, unsolved[i]);
+  }
+  // out is never assigned by the circuit and keeps its initial zero
+}
+
+template <uint SQRTN>
+static bool nativeWitness(const NativeSudokuLayout<SQRTN> &l, Circom_SignalStore &s, const int *unsolved, const int *solved) {
+  std::vector<int> work(3*l.n()*l.n());
+  if (!validBoard(l, unsolved, solved, &work[0])) return false;
+  writeBoard(l, s, MAIN_START, unsolved, solved, &work[0]);
+  return true;
+}
+
+/*
+SudokuBatch(K, sqrtN, N): unsolved[K][N][N], solved[K][N][N], boards[K].
+
+With several threads each one writes whole boards into a store of its own,
+as the boards share the scratch slots of s, and then copies the signals that
+have a slot of their own into s.
+*/
+template <uint SQRTN>
+static bool nativeBatchWitness(const NativeSudokuLayout<SQRTN> &l, uint boards, Circom_SignalStore &s, const int *unsolved, const int *solved, uint nThreads) {
+  const uint cells = l.n()*l.n();
+  const uint workSize = 3*cells;
+  std::vector<int> work((u64)boards*workSize);
+  for (uint b = 0; b < boards; b++) {
+    if (!validBoard(l, &unsolved[b*cells], &solved[b*cells], &work[(u64)b*workSize])) return false;
+  }
+
+  const u64 boardsStart = MAIN_START + 2*(u64)boards*cells;
+  for (uint i = 0; i < boards*cells; i++) {
+    s.setShort(MAIN_START + i, unsolved[i]);
+    s.setShort(MAIN_START + boards*cells + i, solved[i]);
+  }
+
+  if (nThreads > boards) nThreads = boards;
+  if (nThreads <= 1) {
+    for (uint b = 0; b < boards; b++) {
+      writeBoard(l, s, boardsStart + b*l.size(), &unsolved[b*cells], &solved[b*cells], &work[(u64)b*workSize]);
+    }
+    return true;
+  }
+
+  // One slot per signal of a single board
+  std::vector<u32> boardSlots(MAIN_START + l.size());
+  for (u64 i = 0; i < boardSlots.size(); i++) boardSlots[i] = i;
+  std::atomic<uint> next(0);
+  std::vector<std::thread> threads;
+  for (uint t = 0; t < nThreads; t++) {
+    threads.push_back(std::thread([&]() {
+      Circom_SignalStore board(boardSlots.size(), &boardSlots[0], boardSlots.size());
+      for (uint b = next++; b < boards; b = next++) {
+        writeBoard(l, board, MAIN_START, &unsolved[b*cells], &solved[b*cells], &work[(u64)b*workSize]);
+        s.copyOwnSignals(boardsStart + b*l.size(), board, MAIN_START, l.size());
+      }
+    }));
+  }
+  for (auto &t : threads) t.join();
+  return true;
+}
+
+template <uint SQRTN>
+bool sudoku_native_witness(Circom_SignalStore &s, const int *unsolved, const int *solved) {
+  return nativeWitness(NativeSudokuLayout<SQRTN>(SQRTN), s, unsolved, solved);
+}
+
+template bool sudoku_native_witness<2>(Circom_SignalStore &s, const int *unsolved, const int *solved);
+template bool sudoku_native_witness<3>(Circom_SignalStore &s, const int *unsolved, const int *solved);
+template bool sudoku_native_witness<4>(Circom_SignalStore &s, const int *unsolved, const int *solved);
+template bool sudoku_native_witness<5>(Circom_SignalStore &s, const int *unsolved, const int *solved);
+
+bool sudoku_native_witness(uint sqrtN, Circom_SignalStore &s, const int *unsolved, const int *solved) {
+  return nativeWitness(NativeSudokuLayout<0>(sqrtN), s, unsolved, solved);
+}
+
+bool sudoku_native_batch_witness(uint sqrtN, uint boards, Circom_SignalStore &s, const int *unsolved, const int *solved, uint nThreads) {
+  switch (sqrtN) {
+    case 2: return nativeBatchWitness(NativeSudokuLayout<2>(2), boards, s, unsolved, solved, nThreads);
+    case 3: return nativeBatchWitness(NativeSudokuLayout<3>(3), boards, s, unsolved, solved, nThreads);
+    case 4: return nativeBatchWitness(NativeSudokuLayout<4>(4), boards, s, unsolved, solved, nThreads);
+    case 5: return nativeBatchWitness(NativeSudokuLayout<5>(5), boards, s, unsolved, solved, nThreads);
+    default: return nativeBatchWitness(NativeSudokuLayout<0>(sqrtN), boards, s, unsolved, solved, nThreads);
+  }
+}
+
+u64 sudoku_native_signal_no(uint sqrtN) {
+  return MAIN_START + NativeSudokuLayout<0>(sqrtN).size();
+}
+
+u64 sudoku_native_batch_signal_no(uint sqrtN, uint boards) {
+  NativeSudokuLayout<0> l(sqrtN);
+  return MAIN_START + (u64)boards*(2*l.n()*l.n() + l.size());
+}
+
+bool sudoku_native_circuit(SudokuNativeCircuit &c) {
+  const u64 total = get_total_signal_no();
+  const int main = get_main_template_id();
+  const bool batch = strcmp(_templateNames[main], "SudokuBatch") == 0;
+  if (!batch && strcmp(_templateNames[main], "Sudoku") != 0) return false;
+  // A SudokuBatch main has one subcomponent per board
+  const uint boards = batch ? subcomponentNo(main) : 1;
+  for (uint sqrtN = 1; sqrtN <= NATIVE_MAX_SQRTN; sqrtN++) {
+    NativeSudokuLayout<0> l(sqrtN);
+    const u64 cells = (u64)l.n()*l.n();
+    int board = main;
+    if (batch) {
+      if (_templateSignalNo[main] != boards*(2*cells + l.size())) continue;
+      board = subcomponentsAt(main, 0, boards, 2*boards*cells, l.size());
+    }
+    if (MAIN_START + _templateSignalNo[main] != total || !sudokuMatches(l, board)) continue;
+    c.sqrtN = sqrtN;
+    c.boards = boards;
+    c.batch = batch;
+    return true;
+  }
+  return false;
+}
+
+bool run_native(Circom_CalcWit* ctx) {
+  SudokuNativeCircuit c;
+  if (!sudoku_native_circuit(c)) return false;
+  Circom_SignalStore &s = ctx->signalValues;
+  NativeSudokuLayout<0> l(c.sqrtN);
+  const uint cells = c.boards*l.n()*l.n();
+
+  // A Sudoku main starts with out, a SudokuBatch main with the inputs
+  const u64 unsolvedStart = c.batch ? MAIN_START : MAIN_START + l.unsolved();
+  const u64 solvedStart = unsolvedStart + cells;
+  std::vector<int> unsolved(cells);
+  std::vector<int> solved(cells);
+  FrElement e;
+  for (uint i = 0; i < cells; i++) {
+    s.get(unsolvedStart + i, &e);
+    if (e.type & Fr_LONG) return false;
+    unsolved[i] = e.shortVal;
+    s.get(solvedStart + i, &e);
+    if (e.type & Fr_LONG) return false;
+    solved[i] = e.shortVal;
+  }
+
+  if (c.batch) {
+    return sudoku_native_batch_witness(c.sqrtN, c.boards, s, &unsolved[0], &solved[0], ctx->maxThread);
+  }
+  switch (c.sqrtN) {
+    case 2: return sudoku_native_witness<2>(s, &unsolved[0], &solved[0]);
+    case 3: return sudoku_native_witness<3>(s, &unsolved[0], &solved[0]);
+    case 4: return sudoku_native_witness<4>(s, &unsolved[0], &solved[0]);
+    case 5: return sudoku_native_witness<5>(s, &unsolved[0], &solved[0]);
+    default: return sudoku_native_witness(c.sqrtN, s, &unsolved[0], &solved[0]);
+  }
+}
+
+#define PACK_ELEMENT_BITS 252
+
+uint sudoku_pack_bits(uint n) {
+  uint bits = 0;
+  while ((1u << bits) <= n) bits++;
+  return bits;
+}
+
+uint sudoku_packed_size(uint n) {
+  uint perElement = PACK_ELEMENT_BITS / sudoku_pack_bits(n);
+  return (n*n + perElement - 1) / perElement;
+}
+
+void sudoku_pack_board(uint n, const int *cells, FrValue *packed) {
+  const uint bits = sudoku_pack_bits(n);
+  const uint perElement = PACK_ELEMENT_BITS / bits;
+  for (uint e = 0; e < sudoku_packed_size(n); e++) {
+    uint64_t v[4] = {0, 0, 0, 0};
+    for (uint c = 0; c < perElement && e*perElement + c < n*n; c++) {
+      uint64_t x = (uint64_t)cells[e*perElement + c];
+      uint pos = c*bits;
+      v[pos >> 6] |= x << (pos & 0x3F);
+      if ((pos & 0x3F) + bits > 64) v[(pos >> 6) + 1] |= x >> (64 - (pos & 0x3F));
+    }
+    packed[e] = FrValue::fromNormal(v[0], v[1], v[2], v[3]);
+  }
+}
+
+static void packElements(uint n, const int *cells, RawFr::Element *packed) {
+  FrValue values[POSEIDON_MAX_INPUTS];
+  sudoku_pack_board(n, cells, values);
+  for (uint e = 0; e < sudoku_packed_size(n); e++) RawFr::field.fromValue(packed[e], values[e]);
+}
+
+void sudoku_commitment(uint sqrtN, const int *unsolved, RawFr::Element &r) {
+  const uint n = sqrtN*sqrtN;
+  RawFr::Element packed[POSEIDON_MAX_INPUTS];
+  packElements(n, unsolved, packed);
+  Poseidon::get(sudoku_packed_size(n)).hash(r, packed);
+}
+
+void sudoku_commitment_batch(uint sqrtN, u64 count, const int *unsolved, RawFr::Element *r, uint nThreads) {
+  const uint n = sqrtN*sqrtN;
+  const uint elements = sudoku_packed_size(n);
+  std::vector<RawFr::Element> packed(count*elements);
+  for (u64 b = 0; b < count; b++) packElements(n, &unsolved[b*n*n], &packed[b*elements]);
+  Poseidon::get(elements).hashBatch(r, &packed[0], count, nThreads);
+}
+
+static uint64_t boardRng(uint64_t &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+static void boardShuffle(uint64_t &state, int *v, uint n) {
+  for (uint i = n-1; i > 0; i--) {
+    uint j = boardRng(state) % (i+1);
+    int t = v[i];
+    v[i] = v[j];
+    v[j] = t;
+  }
+}
+
+void sudoku_random_board(u64 seed, uint sqrtN, int *unsolved, int *solved) {
+  const uint n = sqrtN*sqrtN;
+  uint64_t state = seed*0x9E3779B97F4A7C15ULL + 1;
+
+  // Permuting the numbers, the bands/stacks and the rows/columns inside
+  // them keeps the pattern board valid
+  std::vector<int> numbers(n), bands(sqrtN), stacks(sqrtN), inBand(sqrtN), rowOrder(n), colOrder(n);
+  for (uint i = 0; i < n; i++) numbers[i] = i+1;
+  for (uint i = 0; i < sqrtN; i++) bands[i] = stacks[i] = i;
+  boardShuffle(state, &numbers[0], n);
+  boardShuffle(state, &bands[0], sqrtN);
+  boardShuffle(state, &stacks[0], sqrtN);
+  for (uint b = 0; b < sqrtN; b++) {
+    for (uint i = 0; i < sqrtN; i++) inBand[i] = i;
+    boardShuffle(state, &inBand[0], sqrtN);
+    for (uint i = 0; i < sqrtN; i++) rowOrder[b*sqrtN + i] = bands[b]*sqrtN + inBand[i];
+    boardShuffle(state, &inBand[0], sqrtN);
+    for (uint i = 0; i < sqrtN; i++) colOrder[b*sqrtN + i] = stacks[b]*sqrtN + inBand[i];
+  }
+
+  uint keep = boardRng(state) % 101;
+  for (uint i = 0; i < n; i++) {
+    for (uint j = 0; j < n; j++) {
+      int r = rowOrder[i];
+      int c = colOrder[j];
+      solved[i*n + j] = numbers[(sqrtN*(r%sqrtN) + r/sqrtN + c) % n];
+      unsolved[i*n + j] = (boardRng(state) % 100 < keep) ? solved[i*n + j] : 0;
+    }
+  }
+}
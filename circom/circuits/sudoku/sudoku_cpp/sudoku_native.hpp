@@ -0,0 +1,80 @@
+#ifndef SUDOKU_NATIVE_H
+#define SUDOKU_NATIVE_H
+
+#include "calcwit.hpp"
+#include "poseidon.hpp"
+
+/*
+Native witness engine for Sudoku(sqrtN, N), N = sqrtN*sqrtN. It writes every
+signal of the generic templates at the same index, using native integers for
+all values and field arithmetic only for the inverses of IsZero and
+DistinctPermutation.
+
+The engine is compiled for sqrtN 2 to 5 (4x4 to 25x25 boards), any other
+size goes through the same code with the size known at run time only.
+
+run_native recognizes the circuit and its board size by the template tables
+of the generated code, the names, sizes and signal offsets of main and of
+all its subcomponents, and returns false, without touching the signals,
+when they are not the Sudoku(sqrtN, N) or SudokuBatch(K, sqrtN, N) layout
+of sudoku_templates.circom or the inputs are not boards the circuit accepts
+(solved cells in 1..N, unsolved cells 0 or equal to the solved one, every
+group a permutation). The generic run then reports the failed assert. The
+boards of a batch are filled by up to maxThread threads.
+*/
+bool run_native(Circom_CalcWit* ctx);
+
+// Number of signals of a Sudoku(sqrtN, sqrtN*sqrtN) circuit, the constant
+// one signal included
+u64 sudoku_native_signal_no(uint sqrtN);
+
+// Same for SudokuBatch(boards, sqrtN, sqrtN*sqrtN)
+u64 sudoku_native_batch_signal_no(uint sqrtN, uint boards);
+
+struct SudokuNativeCircuit {
+  uint sqrtN;
+  uint boards;
+  bool batch;
+};
+
+// Shape of the compiled circuit, false when its template tables are not the
+// ones of a Sudoku or a SudokuBatch main
+bool sudoku_native_circuit(SudokuNativeCircuit &c);
+
+// Writes the signals of a Sudoku(sqrtN, N) main component starting at signal
+// 1 of s from the N*N cells of unsolved and solved. Returns false without
+// writing anything when the board is not accepted by the circuit.
+template <uint SQRTN>
+bool sudoku_native_witness(Circom_SignalStore &s, const int *unsolved, const int *solved);
+
+// Same with sqrtN only known at run time
+bool sudoku_native_witness(uint sqrtN, Circom_SignalStore &s, const int *unsolved, const int *solved);
+
+// Writes the signals of a SudokuBatch(boards, sqrtN, N) main component from
+// the boards*N*N cells of unsolved and solved, using up to nThreads threads.
+// Returns false without writing anything when a board is not accepted.
+bool sudoku_native_batch_witness(uint sqrtN, uint boards, Circom_SignalStore &s, const int *unsolved, const int *solved, uint nThreads);
+
+// Number of field elements of a board of n*n cells packed as PackedSudoku
+// packs it, nbits(n) bits per cell, 252 bits per element
+uint sudoku_packed_size(uint n);
+
+// Bits of each packed cell, cells must be below 2^bits
+uint sudoku_pack_bits(uint n);
+
+// Packs the n*n cells into sudoku_packed_size(n) elements, the first cell in
+// the lowest bits
+void sudoku_pack_board(uint n, const int *cells, FrValue *packed);
+
+// Poseidon commitment of CommittedSudoku(sqrtN, N): Poseidon of the packed
+// unsolved board
+void sudoku_commitment(uint sqrtN, const int *unsolved, RawFr::Element &r);
+
+// Commitments of count boards of N*N cells each, on up to nThreads threads
+void sudoku_commitment_batch(uint sqrtN, u64 count, const int *unsolved, RawFr::Element *r, uint nThreads);
+
+// A random valid solved board and a puzzle keeping each of its cells with a
+// random probability, as used by the --verify-native corpus
+void sudoku_random_board(u64 seed, uint sqrtN, int *unsolved, int *solved);
+
+#endif // SUDOKU_NATIVE_H
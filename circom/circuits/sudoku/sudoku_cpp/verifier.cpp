@@ -0,0 +1,232 @@
+#include <gmp.h>
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+#include "msm.hpp"
+#include "verifier.hpp"
+
+using json = nlohmann::json;
+
+static const char *fqModulus = "21888242871839275222246405745257275088696311157297823662689037894645226208583";
+static const char *frModulus = "21888242871839275222246405745257275088548364400416034343698204186575808495617";
+
+static json readJson(const std::string &fileName) {
+    std::ifstream f(fileName);
+    if (!f) throw std::runtime_error("cannot open " + fileName);
+    json j;
+    f >> j;
+    return j;
+}
+
+// A decimal string below the modulus to its normal form limbs
+static void parseDecimal(const json &value, const char *modulus, uint64_t *limbs) {
+    std::string s = value.get<std::string>();
+    mpz_t z, m;
+    mpz_init(z);
+    mpz_init_set_str(m, modulus, 10);
+    bool ok = !s.empty() && mpz_set_str(z, s.c_str(), 10) == 0 && mpz_sgn(z) >= 0 && mpz_cmp(z, m) < 0;
+    for (int k = 0; k < 4; k++) limbs[k] = 0;
+    if (ok) mpz_export(limbs, NULL, -1, 8, 0, 0, z);
+    mpz_clear(z);
+    mpz_clear(m);
+    if (!ok) throw std::runtime_error("invalid field element " + s);
+}
+
+static FqValue parseFq(const json &value) {
+    uint64_t v[4];
+    parseDecimal(value, fqModulus, v);
+    return FqValue::fromNormal(v[0], v[1], v[2], v[3]);
+}
+
+static FrValue parseFr(const json &value) {
+    uint64_t v[4];
+    parseDecimal(value, frModulus, v);
+    return FrValue::fromNormal(v[0], v[1], v[2], v[3]);
+}
+
+static Fq2Value parseFq2(const json &value) {
+    return Fq2Value(parseFq(value.at(0)), parseFq(value.at(1)));
+}
+
+// [x, y, z] with z 1, or 0 for the point at infinity
+static G1Affine parseG1(const json &value, const char *name) {
+    G1Affine p;
+    FqValue z = parseFq(value.at(2));
+    if (z == FqValue::one()) {
+        p.x = parseFq(value.at(0));
+        p.y = parseFq(value.at(1));
+    } else if (!z.isZero()) {
+        throw std::runtime_error(std::string(name) + ": not an affine point");
+    }
+    if (!G1_isOnCurve(p)) throw std::runtime_error(std::string(name) + ": not on the curve");
+    return p;
+}
+
+// As parseG1 on the twist. The subgroup of the B of a proof is checked when
+// it is verified, so a bad proof in a batch is reported and not thrown.
+static G2Affine parseG2(const json &value, const char *name, bool checkSubgroup) {
+    G2Affine p;
+    Fq2Value z = parseFq2(value.at(2));
+    if (z == Fq2Value::one()) {
+        p.x = parseFq2(value.at(0));
+        p.y = parseFq2(value.at(1));
+    } else if (!z.isZero()) {
+        throw std::runtime_error(std::string(name) + ": not an affine point");
+    }
+    if (!G2_isOnCurve(p)) throw std::runtime_error(std::string(name) + ": not on the curve");
+    if (checkSubgroup && !G2_inSubgroup(p)) throw std::runtime_error(std::string(name) + ": not in G2");
+    return p;
+}
+
+void Groth16_readVerificationKey(const std::string &fileName, Groth16_VerificationKey &vk) {
+    json j = readJson(fileName);
+    if (j.at("protocol").get<std::string>() != "groth16") {
+        throw std::runtime_error(fileName + ": not a groth16 verification key");
+    }
+    vk.alpha1 = parseG1(j.at("vk_alpha_1"), "vk_alpha_1");
+    vk.beta2 = parseG2(j.at("vk_beta_2"), "vk_beta_2", true);
+    vk.gamma2 = parseG2(j.at("vk_gamma_2"), "vk_gamma_2", true);
+    vk.delta2 = parseG2(j.at("vk_delta_2"), "vk_delta_2", true);
+    const json &ic = j.at("IC");
+    vk.IC.clear();
+    for (size_t i = 0; i < ic.size(); i++) vk.IC.push_back(parseG1(ic.at(i), "IC"));
+    vk.nPublic = j.at("nPublic").get<uint32_t>();
+    if (vk.IC.size() != (uint64_t)vk.nPublic + 1) {
+        throw std::runtime_error(fileName + ": " + std::to_string(vk.IC.size()) + " IC points for " +
+                                 std::to_string(vk.nPublic) + " public inputs");
+    }
+    G2Affine fixed[3] = {vk.beta2, vk.gamma2, vk.delta2};
+    pairing_prepare(fixed, 3, vk.prepared);
+}
+
+void Groth16_readProof(const std::string &fileName, Groth16_Proof &proof) {
+    json j = readJson(fileName);
+    proof.a = parseG1(j.at("pi_a"), "pi_a");
+    proof.b = parseG2(j.at("pi_b"), "pi_b", false);
+    proof.c = parseG1(j.at("pi_c"), "pi_c");
+}
+
+void Groth16_readPublic(const std::string &fileName, std::vector<FrValue> &publics) {
+    json j = readJson(fileName);
+    publics.clear();
+    for (size_t i = 0; i < j.size(); i++) publics.push_back(parseFr(j.at(i)));
+}
+
+// A random non zero factor below 2^128
+static FrValue randomFactor(std::random_device &rd) {
+    std::uniform_int_distribution<uint64_t> dist;
+    while (true) {
+        FrValue r = FrValue::fromNormal(dist(rd), dist(rd), 0, 0);
+        if (!r.isZero()) return r;
+    }
+}
+
+// The product with n = 1 and r = 1 is the plain Groth16 check
+static bool checkProduct(const Groth16_VerificationKey &vk, const Groth16_Proof *proofs,
+                         const std::vector<FrValue> *publics, const uint64_t *index, uint64_t n,
+                         const FrValue *r, unsigned nThreads) {
+    // sum(r_i*L_i) as sum(r_i)*IC[0] + sum(sum(r_i*public[i][j])*IC[j+1])
+    std::vector<FrValue> icFactors(vk.nPublic + 1);
+    for (uint64_t i = 0; i < n; i++) {
+        const std::vector<FrValue> &pub = publics[index[i]];
+        icFactors[0] = icFactors[0] + r[i];
+        for (uint32_t k = 0; k < vk.nPublic; k++) icFactors[k+1] = icFactors[k+1] + r[i]*pub[k];
+    }
+    std::vector<uint64_t> scalars((vk.nPublic + 1)*Fr_N64);
+    for (uint32_t k = 0; k <= vk.nPublic; k++) {
+        FrValue s = icFactors[k].toNormal();
+        for (int l = 0; l < Fr_N64; l++) scalars[k*Fr_N64 + l] = s.v[l];
+    }
+    G1Point l = msm(&vk.IC[0], &scalars[0], vk.nPublic + 1, nThreads);
+
+    std::vector<G1Affine> cs(n);
+    scalars.assign(n*Fr_N64, 0);
+    for (uint64_t i = 0; i < n; i++) {
+        cs[i] = proofs[index[i]].c;
+        FrValue s = r[i].toNormal();
+        for (int k = 0; k < Fr_N64; k++) scalars[i*Fr_N64 + k] = s.v[k];
+    }
+    G1Point c = msm(&cs[0], &scalars[0], n, nThreads);
+
+    G1Affine fixed[3] = {G1Point(vk.alpha1).mul(icFactors[0]).toAffine(), l.toAffine(), c.toAffine()};
+    Fq12Value f = pairing_millerLoop(fixed, vk.prepared, 3);
+
+    // The pairs of the proofs, the threads take contiguous ranges and
+    // prepare their B together
+    if (nThreads == 0) nThreads = 1;
+    if (nThreads > n) nThreads = n;
+    const uint64_t perThread = (n + nThreads - 1) / nThreads;
+    std::vector<Fq12Value> partial(nThreads, Fq12Value::one());
+    msm_parallel(nThreads, [&](unsigned t) {
+        uint64_t from = t*perThread;
+        uint64_t to = std::min(n, from + perThread);
+        if (from >= to) return;
+        std::vector<G1Affine> a(to - from);
+        std::vector<G2Affine> b(to - from);
+        std::vector<G2Prepared> prepared(to - from);
+        for (uint64_t i = from; i < to; i++) {
+            const Groth16_Proof &proof = proofs[index[i]];
+            a[i - from] = (-G1Point(proof.a).mul(r[i])).toAffine();
+            b[i - from] = proof.b;
+        }
+        pairing_prepare(&b[0], to - from, &prepared[0]);
+        partial[t] = pairing_millerLoop(&a[0], &prepared[0], to - from);
+    });
+    for (auto &p : partial) f = f*p;
+
+    return pairing_finalExp(f).isOne();
+}
+
+static bool wellFormed(const Groth16_VerificationKey &vk, const Groth16_Proof &proof, const std::vector<FrValue> &publics) {
+    return publics.size() == vk.nPublic &&
+           G1_isOnCurve(proof.a) && G1_isOnCurve(proof.c) && G2_inSubgroup(proof.b);
+}
+
+bool Groth16_verify(const Groth16_VerificationKey &vk, const Groth16_Proof &proof, const std::vector<FrValue> &publics) {
+    if (!wellFormed(vk, proof, publics)) return false;
+    const uint64_t index = 0;
+    const FrValue one = FrValue::one();
+    return checkProduct(vk, &proof, &publics, &index, 1, &one, 1);
+}
+
+bool Groth16_verifyBatch(const Groth16_VerificationKey &vk, const Groth16_Proof *proofs,
+                         const std::vector<FrValue> *publics, uint64_t n, unsigned nThreads,
+                         std::vector<bool> *valid) {
+    if (valid) valid->assign(n, false);
+    if (nThreads == 0) nThreads = 1;
+
+    // Malformed proofs are invalid without pairing, the others go in the batch
+    std::vector<uint64_t> index;
+    for (uint64_t i = 0; i < n; i++) {
+        if (wellFormed(vk, proofs[i], publics[i])) index.push_back(i);
+    }
+    if (index.empty()) return n == 0;
+
+    std::vector<FrValue> r(index.size(), FrValue::one());
+    if (index.size() > 1) {
+        std::random_device rd;
+        for (auto &x : r) x = randomFactor(rd);
+    }
+    if (checkProduct(vk, proofs, publics, &index[0], index.size(), &r[0], nThreads)) {
+        if (valid) for (uint64_t i : index) (*valid)[i] = true;
+        return index.size() == n;
+    }
+    if (!valid) return false;
+
+    // One by one to find the invalid ones
+    const FrValue one = FrValue::one();
+    const uint64_t m = index.size();
+    const unsigned nWorkers = nThreads < m ? nThreads : m;
+    std::vector<char> ok(m, 0);
+    msm_parallel(nWorkers, [&](unsigned t) {
+        for (uint64_t i = t; i < m; i += nWorkers) {
+            ok[i] = checkProduct(vk, proofs, publics, &index[i], 1, &one, 1);
+        }
+    });
+    for (uint64_t i = 0; i < m; i++) (*valid)[index[i]] = ok[i];
+    return false;
+}
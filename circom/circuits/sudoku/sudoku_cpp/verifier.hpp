@@ -0,0 +1,62 @@
+#ifndef __VERIFIER_H
+#define __VERIFIER_H
+
+#include <string>
+#include <vector>
+
+#include "groth16.hpp"
+#include "pairing.hpp"
+
+/*
+Native Groth16 verifier for snarkjs verification keys, the check of
+"snarkjs groth16 verify":
+
+    e(A, B) == e(alpha, beta)*e(L, gamma)*e(C, delta)
+
+with L = IC[0] + sum(public[j]*IC[j+1]), done as one product of four
+pairings that is 1, so a single final exponentiation.
+
+A batch of n proofs of the same key is checked with random 128 bit factors
+r_i as one product
+
+    prod(e(-r_i*A_i, B_i)) * e(sum(r_i)*alpha, beta)
+      * e(sum(r_i*L_i), gamma) * e(sum(r_i*C_i), delta) == 1
+
+so the fixed pairs are paired once for the whole batch, sum(r_i*C_i) is one
+multi scalar multiplication, and there is one final exponentiation instead
+of n. A batch with an invalid proof passes with probability about 2^-128.
+When the batch fails the proofs are checked one by one to tell which ones
+are invalid.
+
+The points of the proofs are checked to be on the curves and B in the
+subgroup of order r, and the public inputs to be lower than r.
+*/
+
+struct Groth16_VerificationKey {
+    uint32_t nPublic;
+    G1Affine alpha1;
+    G2Affine beta2;
+    G2Affine gamma2;
+    G2Affine delta2;
+    std::vector<G1Affine> IC;                   // nPublic + 1 points
+
+    G2Prepared prepared[3];                     // beta2, gamma2 and delta2
+};
+
+// verification_key.json, proof.json and public.json as snarkjs writes them,
+// throw std::runtime_error on values that are not on the curve or not in
+// the field
+void Groth16_readVerificationKey(const std::string &fileName, Groth16_VerificationKey &vk);
+void Groth16_readProof(const std::string &fileName, Groth16_Proof &proof);
+void Groth16_readPublic(const std::string &fileName, std::vector<FrValue> &publics);
+
+bool Groth16_verify(const Groth16_VerificationKey &vk, const Groth16_Proof &proof, const std::vector<FrValue> &publics);
+
+// Verifies the n pairs proofs[i], publics[i] as one batch with nThreads
+// splitting the Miller loops. valid, when given, gets the result of every
+// proof.
+bool Groth16_verifyBatch(const Groth16_VerificationKey &vk, const Groth16_Proof *proofs,
+                         const std::vector<FrValue> *publics, uint64_t n, unsigned nThreads = 1,
+                         std::vector<bool> *valid = nullptr);
+
+#endif // __VERIFIER_H
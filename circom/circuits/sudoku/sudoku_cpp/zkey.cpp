@@ -0,0 +1,304 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fstream>
+#include <initializer_list>
+#include <map>
+#include <new>
+#include <stdexcept>
+
+#include "zkey.hpp"
+
+static const uint64_t Fq_q[4] = {0x3c208c16d87cfd47ULL, 0x97816a916871ca8dULL, 0xb85045b68181585dULL, 0x30644e72e131a029ULL};
+
+// Alignment of the sections of a cache file, a cache line
+#define ZKEY_CACHE_ALIGN 64
+
+// Section of the cache file with the size and time of its .zkey
+#define ZKEY_CACHE_SOURCE 100
+
+namespace {
+
+// An iden3 binary file mapped read only, with the position of every section
+class BinFile {
+public:
+    BinFile(const std::string &fileName, std::initializer_list<const char *> magics) : name(fileName) {
+        int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + fileName);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < 12) {
+            close(fd);
+            fail("not an iden3 binary file");
+        }
+        size = st.st_size;
+        void *p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) fail("cannot map the file");
+        const uint64_t length = size;
+        mapping = std::shared_ptr<const void>(p, [length](const void *q) { munmap(const_cast<void *>(q), length); });
+        data = (const uint8_t *)p;
+
+        bool known = false;
+        for (const char *m : magics) known |= memcmp(data, m, 4) == 0;
+        if (!known) fail("not a ." + std::string(*magics.begin(), 4) + " file");
+        uint32_t nSections = u32(8);
+        uint64_t pos = 12;
+        for (uint32_t i = 0; i < nSections; i++) {
+            if (pos + 12 > size) fail("truncated section header");
+            uint32_t type = u32(pos);
+            uint64_t sectionSize = u64(pos + 4);
+            pos += 12;
+            if (sectionSize > size - pos) fail("truncated section");
+            sections[type] = std::make_pair(pos, sectionSize);
+            pos += sectionSize;
+        }
+    }
+
+    bool hasSection(uint32_t type) const { return sections.count(type) != 0; }
+
+    // Start of section type, which must hold at least minSize bytes
+    uint64_t section(uint32_t type, uint64_t minSize = 0) {
+        auto it = sections.find(type);
+        if (it == sections.end()) fail("missing section " + std::to_string(type));
+        if (it->second.second < minSize) fail("short section " + std::to_string(type));
+        return it->second.first;
+    }
+
+    uint64_t sectionSize(uint32_t type) {
+        section(type);
+        return sections[type].second;
+    }
+
+    uint32_t u32(uint64_t pos) const { uint32_t v; memcpy(&v, &data[pos], 4); return v; }
+    uint64_t u64(uint64_t pos) const { uint64_t v; memcpy(&v, &data[pos], 8); return v; }
+    const uint8_t *at(uint64_t pos) const { return &data[pos]; }
+
+    template <class T>
+    void read(uint32_t type, std::vector<T> &v, uint64_t count) {
+        uint64_t pos = section(type, count*sizeof(T));
+        v.resize(count);
+        if (count) memcpy(&v[0], at(pos), count*sizeof(T));
+    }
+
+    // count values at offset of section type, in place when they are
+    // aligned for T, else copied to aligned memory
+    template <class T>
+    Groth16_View<T> view(uint32_t type, uint64_t count, uint64_t offset = 0) {
+        uint64_t pos = section(type, offset + count*sizeof(T)) + offset;
+        if (count == 0) return Groth16_View<T>();
+        const uint8_t *p = at(pos);
+        if ((uintptr_t)p % alignof(T) == 0) return Groth16_View<T>((const T *)p, count, mapping);
+        void *mem;
+        if (posix_memalign(&mem, ZKEY_CACHE_ALIGN, count*sizeof(T)) != 0) throw std::bad_alloc();
+        memcpy(mem, p, count*sizeof(T));
+        return Groth16_View<T>((const T *)mem, count, std::shared_ptr<const void>(mem, free));
+    }
+
+    [[noreturn]] void fail(const std::string &what) const {
+        throw std::runtime_error(name + ": " + what);
+    }
+
+private:
+    std::string name;
+    uint64_t size;
+    const uint8_t *data;
+    std::shared_ptr<const void> mapping;
+    std::map<uint32_t, std::pair<uint64_t, uint64_t>> sections;
+};
+
+// Writes an iden3 binary file with the data of every section at a multiple
+// of ZKEY_CACHE_ALIGN bytes, a padding section of type 0 before each one
+class BinWriter {
+public:
+    struct Piece {
+        const void *data;
+        uint64_t size;
+    };
+
+    BinWriter(const std::string &fileName, const char *magic, uint32_t nSections) : name(fileName), f(fileName, std::ios::binary) {
+        if (!f) throw std::runtime_error("cannot write " + fileName);
+        f.write(magic, 4);
+        put32(1);
+        put32(2*nSections);
+        pos = 12;
+    }
+
+    void section(uint32_t type, std::initializer_list<Piece> pieces) {
+        static const char zeros[ZKEY_CACHE_ALIGN] = {};
+        uint64_t pad = (ZKEY_CACHE_ALIGN - (pos + 24) % ZKEY_CACHE_ALIGN) % ZKEY_CACHE_ALIGN;
+        put32(0);
+        put64(pad);
+        f.write(zeros, pad);
+        uint64_t size = 0;
+        for (auto &p : pieces) size += p.size;
+        put32(type);
+        put64(size);
+        for (auto &p : pieces) f.write((const char *)p.data, p.size);
+        pos += 24 + pad + size;
+    }
+
+    void close() {
+        f.close();
+        if (!f) throw std::runtime_error("cannot write " + name);
+    }
+
+private:
+    std::string name;
+    std::ofstream f;
+    uint64_t pos;
+
+    void put32(uint32_t v) { f.write((const char *)&v, 4); }
+    void put64(uint64_t v) { f.write((const char *)&v, 8); }
+};
+
+// Size and modification time of a file, what the cache is checked against
+struct SourceStamp {
+    uint64_t size;
+    int64_t seconds;
+    int64_t nanoseconds;
+};
+
+SourceStamp sourceStamp(const std::string &fileName) {
+    struct stat st;
+    if (stat(fileName.c_str(), &st) != 0) throw std::runtime_error("cannot open " + fileName);
+    SourceStamp s;
+    s.size = st.st_size;
+#ifdef __APPLE__
+    s.seconds = st.st_mtimespec.tv_sec;
+    s.nanoseconds = st.st_mtimespec.tv_nsec;
+#else
+    s.seconds = st.st_mtim.tv_sec;
+    s.nanoseconds = st.st_mtim.tv_nsec;
+#endif
+    return s;
+}
+
+}
+
+// The sections 1 to 9, the same in a .zkey and in a cache
+static void readZKey(BinFile &f, Groth16_ZKey &zkey) {
+    if (f.u32(f.section(1, 4)) != 1) f.fail("not a Groth16 key");
+
+    // Header: the two moduli, the sizes and the fixed points
+    uint64_t pos = f.section(2, 4 + 32 + 4 + 32 + 12 + 3*sizeof(G1Affine) + 3*sizeof(G2Affine));
+    if (f.u32(pos) != 32 || memcmp(f.at(pos + 4), Fq_q, 32) != 0) f.fail("base field is not bn128");
+    pos += 36;
+    if (f.u32(pos) != 32 || memcmp(f.at(pos + 4), Fr_q.longVal, 32) != 0) f.fail("scalar field is not bn128");
+    pos += 36;
+    zkey.nVars = f.u32(pos);
+    zkey.nPublic = f.u32(pos + 4);
+    zkey.domainSize = f.u32(pos + 8);
+    pos += 12;
+    if (zkey.nPublic + 1 > zkey.nVars) f.fail("more public signals than signals");
+    if (zkey.domainSize == 0 || (zkey.domainSize & (zkey.domainSize - 1))) f.fail("domain size is not a power of two");
+
+    memcpy(&zkey.alpha1, f.at(pos), sizeof(G1Affine)); pos += sizeof(G1Affine);
+    memcpy(&zkey.beta1, f.at(pos), sizeof(G1Affine)); pos += sizeof(G1Affine);
+    memcpy(&zkey.beta2, f.at(pos), sizeof(G2Affine)); pos += sizeof(G2Affine);
+    memcpy(&zkey.gamma2, f.at(pos), sizeof(G2Affine)); pos += sizeof(G2Affine);
+    memcpy(&zkey.delta1, f.at(pos), sizeof(G1Affine)); pos += sizeof(G1Affine);
+    memcpy(&zkey.delta2, f.at(pos), sizeof(G2Affine));
+
+    zkey.IC = f.view<G1Affine>(3, zkey.nPublic + 1);
+
+    // Groth16_Coef is packed, the coefficients are never copied
+    uint32_t nCoefs = f.u32(f.section(4, 4));
+    zkey.coefs = f.view<Groth16_Coef>(4, nCoefs, 4);
+    for (auto &c : zkey.coefs) {
+        if (c.matrix > 1 || c.constraint >= zkey.domainSize || c.signal >= zkey.nVars) f.fail("coefficient out of range");
+    }
+
+    zkey.A = f.view<G1Affine>(5, zkey.nVars);
+    zkey.B1 = f.view<G1Affine>(6, zkey.nVars);
+    zkey.B2 = f.view<G2Affine>(7, zkey.nVars);
+    zkey.C = f.view<G1Affine>(8, zkey.nVars - zkey.nPublic - 1);
+    zkey.H = f.view<G1Affine>(9, zkey.domainSize);
+}
+
+void Groth16_readZKey(const std::string &fileName, Groth16_ZKey &zkey) {
+    BinFile f(fileName, {"zkey", "zkyc"});
+    readZKey(f, zkey);
+}
+
+void Groth16_writeZKeyCache(const Groth16_ZKey &zkey, const std::string &zkeyFileName, const std::string &cacheFileName) {
+    SourceStamp stamp = sourceStamp(zkeyFileName);
+    const uint32_t protocol = 1, n8 = 32, nCoefs = zkey.coefs.size();
+    const uint32_t sizes[3] = {zkey.nVars, zkey.nPublic, zkey.domainSize};
+
+    // Written next to the cache and renamed, a reader never sees half a file
+    const std::string tmpFileName = cacheFileName + ".tmp";
+    BinWriter w(tmpFileName, "zkyc", 10);
+    w.section(1, {{&protocol, 4}});
+    w.section(2, {{&n8, 4}, {Fq_q, 32}, {&n8, 4}, {Fr_q.longVal, 32}, {sizes, 12},
+                  {&zkey.alpha1, sizeof(G1Affine)}, {&zkey.beta1, sizeof(G1Affine)},
+                  {&zkey.beta2, sizeof(G2Affine)}, {&zkey.gamma2, sizeof(G2Affine)},
+                  {&zkey.delta1, sizeof(G1Affine)}, {&zkey.delta2, sizeof(G2Affine)}});
+    w.section(3, {{zkey.IC.data(), zkey.IC.size()*sizeof(G1Affine)}});
+    // the coefficients after their count, aligned as the points need not be
+    w.section(4, {{&nCoefs, 4}, {zkey.coefs.data(), nCoefs*sizeof(Groth16_Coef)}});
+    w.section(5, {{zkey.A.data(), zkey.A.size()*sizeof(G1Affine)}});
+    w.section(6, {{zkey.B1.data(), zkey.B1.size()*sizeof(G1Affine)}});
+    w.section(7, {{zkey.B2.data(), zkey.B2.size()*sizeof(G2Affine)}});
+    w.section(8, {{zkey.C.data(), zkey.C.size()*sizeof(G1Affine)}});
+    w.section(9, {{zkey.H.data(), zkey.H.size()*sizeof(G1Affine)}});
+    w.section(ZKEY_CACHE_SOURCE, {{&stamp, sizeof(stamp)}});
+    w.close();
+    if (rename(tmpFileName.c_str(), cacheFileName.c_str()) != 0) {
+        unlink(tmpFileName.c_str());
+        throw std::runtime_error("cannot write " + cacheFileName);
+    }
+}
+
+void Groth16_readZKeyCached(const std::string &zkeyFileName, const std::string &cacheFileName, Groth16_ZKey &zkey) {
+    SourceStamp stamp = sourceStamp(zkeyFileName);
+    try {
+        BinFile f(cacheFileName, {"zkyc"});
+        SourceStamp cached;
+        memcpy(&cached, f.at(f.section(ZKEY_CACHE_SOURCE, sizeof(cached))), sizeof(cached));
+        if (cached.size == stamp.size && cached.seconds == stamp.seconds && cached.nanoseconds == stamp.nanoseconds) {
+            readZKey(f, zkey);
+            return;
+        }
+    } catch (std::runtime_error &) {
+        // a missing or broken cache is written again
+    }
+    Groth16_readZKey(zkeyFileName, zkey);
+    Groth16_writeZKeyCache(zkey, zkeyFileName, cacheFileName);
+}
+
+void Groth16_readPtau(const std::string &fileName, Groth16_Ptau &ptau) {
+    BinFile f(fileName, {"ptau"});
+
+    uint64_t pos = f.section(1, 4 + 32 + 8);
+    if (f.u32(pos) != 32 || memcmp(f.at(pos + 4), Fq_q, 32) != 0) f.fail("base field is not bn128");
+    ptau.power = f.u32(pos + 36);
+    ptau.ceremonyPower = f.u32(pos + 40);
+    if (ptau.power > 28) f.fail("more than 2^28 powers");
+
+    const uint64_t n = (uint64_t)1 << ptau.power;
+    ptau.tauG1 = f.view<G1Affine>(2, 2*n - 1);
+    ptau.tauG2 = f.view<G2Affine>(3, n);
+    ptau.alphaTauG1 = f.view<G1Affine>(4, n);
+    ptau.betaTauG1 = f.view<G1Affine>(5, n);
+    memcpy(&ptau.betaG2, f.at(f.section(6, sizeof(G2Affine))), sizeof(G2Affine));
+
+    if (f.hasSection(12)) {
+        ptau.lTauG1 = f.view<G1Affine>(12, 2*n - 1);
+        ptau.lTauG2 = f.view<G2Affine>(13, 2*n - 1);
+        ptau.lAlphaTauG1 = f.view<G1Affine>(14, 2*n - 1);
+        ptau.lBetaTauG1 = f.view<G1Affine>(15, 2*n - 1);
+    }
+}
+
+void Groth16_readWtns(const std::string &fileName, std::vector<uint64_t> &witness) {
+    BinFile f(fileName, {"wtns"});
+
+    uint64_t pos = f.section(1, 4 + 32 + 4);
+    if (f.u32(pos) != 32 || memcmp(f.at(pos + 4), Fr_q.longVal, 32) != 0) f.fail("field is not bn128");
+    uint32_t nVars = f.u32(pos + 36);
+
+    f.read(2, witness, (uint64_t)nVars*Fr_N64);
+}
@@ -0,0 +1,120 @@
+#ifndef __ZKEY_H
+#define __ZKEY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "curve.hpp"
+
+/*
+Readers of the snarkjs binary files the prover needs: the Groth16 proving
+key (.zkey), the powers of tau (.ptau) and the witness (.wtns).
+
+All are "iden3 binary" files: a 4 byte magic, a u32 version, a u32 section
+count and then the sections, each a u32 type, a u64 size and the data. All
+numbers are little endian. Field elements and points are stored in
+Montgomery form (LEM), the layout of FqValue limbs.
+
+The files are mapped read only and the point and coefficient arrays are
+Groth16_View views of the mapping, so loading a key reads its headers and
+the coefficient indices and nothing else: the pages of the points are read
+by the first proof that uses them. A view needs its section at an address
+aligned for its type. The sections of a .zkey are not, snarkjs puts them
+one after the other, so their points are copied. Groth16_readZKeyCached
+writes the key once to a cache file with every section aligned, and later
+loads map it without copying.
+
+Errors, a missing file, a wrong magic, another curve or a truncated section,
+throw std::runtime_error.
+*/
+
+// count values of type T, in a file mapping or in memory of their own. The
+// mapping or the memory is released with the last view of it.
+template <class T>
+class Groth16_View {
+public:
+    Groth16_View() : ptr(nullptr), n(0) {}
+    Groth16_View(const T *p, uint64_t count, std::shared_ptr<const void> owner) : ptr(p), n(count), keep(owner) {}
+
+    const T *data() const { return ptr; }
+    uint64_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    const T &operator[](uint64_t i) const { return ptr[i]; }
+    const T *begin() const { return ptr; }
+    const T *end() const { return ptr + n; }
+
+private:
+    const T *ptr;
+    uint64_t n;
+    std::shared_ptr<const void> keep;
+};
+
+// One non zero coefficient of the A or B matrix of the R1CS. value is
+// coef*R^2 mod r, a Montgomery multiplication by a witness value in normal
+// form gives coef*w in Montgomery form.
+struct __attribute__((__packed__)) Groth16_Coef {
+    uint32_t matrix;      // 0 A, 1 B
+    uint32_t constraint;
+    uint32_t signal;
+    FrRawElement value;
+};
+
+struct Groth16_ZKey {
+    uint32_t nVars;
+    uint32_t nPublic;
+    uint32_t domainSize;
+
+    G1Affine alpha1;
+    G1Affine beta1;
+    G2Affine beta2;
+    G2Affine gamma2;
+    G1Affine delta1;
+    G2Affine delta2;
+
+    Groth16_View<G1Affine> IC;      // nPublic + 1
+    Groth16_View<Groth16_Coef> coefs;
+    Groth16_View<G1Affine> A;       // nVars
+    Groth16_View<G1Affine> B1;      // nVars
+    Groth16_View<G2Affine> B2;      // nVars
+    Groth16_View<G1Affine> C;       // nVars - nPublic - 1
+    Groth16_View<G1Affine> H;       // domainSize
+};
+
+// Reads a .zkey, or a cache written by Groth16_writeZKeyCache
+void Groth16_readZKey(const std::string &fileName, Groth16_ZKey &zkey);
+
+// Writes the sections the prover uses, each aligned to 64 bytes, with the
+// size and modification time of the .zkey it comes from
+void Groth16_writeZKeyCache(const Groth16_ZKey &zkey, const std::string &zkeyFileName, const std::string &cacheFileName);
+
+// Loads cacheFileName when it was written from zkeyFileName as it is now,
+// else reads zkeyFileName and writes the cache for the next time
+void Groth16_readZKeyCached(const std::string &zkeyFileName, const std::string &cacheFileName, Groth16_ZKey &zkey);
+
+// The powers of tau of the phase 1 ceremony, the Lagrange sections only in
+// the files "snarkjs powersoftau prepare phase2" writes
+struct Groth16_Ptau {
+    uint32_t power;
+    uint32_t ceremonyPower;
+
+    G2Affine betaG2;
+
+    Groth16_View<G1Affine> tauG1;        // tau^i*G1, 2^(power+1) - 1
+    Groth16_View<G2Affine> tauG2;        // tau^i*G2, 2^power
+    Groth16_View<G1Affine> alphaTauG1;   // 2^power
+    Groth16_View<G1Affine> betaTauG1;    // 2^power
+    // The Lagrange basis of the domains 2^0 to 2^power one after the
+    // other, 2^(power+1) - 1, empty when not prepared
+    Groth16_View<G1Affine> lTauG1;
+    Groth16_View<G2Affine> lTauG2;
+    Groth16_View<G1Affine> lAlphaTauG1;
+    Groth16_View<G1Affine> lBetaTauG1;
+};
+
+void Groth16_readPtau(const std::string &fileName, Groth16_Ptau &ptau);
+
+// The witness values in normal form, Fr_N64 limbs each
+void Groth16_readWtns(const std::string &fileName, std::vector<uint64_t> &witness);
+
+#endif // __ZKEY_H
@@ -0,0 +1,4 @@
+pragma circom 2.0.0;
+include "sudoku_templates.circom";
+
+component main {public [packed]} = PackedSudoku(3, 9);
@@ -0,0 +1,272 @@
+pragma circom 2.0.0;
+include "../node_modules/circomlib/circuits/comparators.circom";
+include "../node_modules/circomlib/circuits/poseidon.circom";
+include "permutation.circom";
+
+template Sudoku(sqrtN, N) {
+    signal input unsolved[N][N];
+    signal input solved[N][N];
+    signal output out;
+
+    // check that the numbers make sense, this is the only range check of
+    // the solved cells and the subgroup verifiers below rely on it
+    component numbersVerifier = SudokuNumberVerifier(N);
+    for (var i = 0; i < N; i++) {
+        for (var j = 0; j < N; j++) {
+            numbersVerifier.in[i*N + j] <== solved[i][j];
+        }
+    }
+    numbersVerifier.out === 1;
+
+    
+    // verify the rows
+    component rowVerifiers[N];
+    for (var i = 0; i < N; i++) {
+        rowVerifiers[i] = SubgroupVerifier(N);
+        for (var j = 0; j < N; j++) {
+            rowVerifiers[i].in[j] <== solved[i][j];
+        }
+        rowVerifiers[i].out === 1;
+    }
+
+    // verify the columns
+    component columnVerifiers[N];
+    for (var i = 0; i < N; i++) {
+        columnVerifiers[i] = SubgroupVerifier(N);
+        for (var j = 0; j < N; j++) {
+            columnVerifiers[i].in[j] <== solved[j][i];
+        }
+        columnVerifiers[i].out === 1;
+    }
+
+    // verify the boxes
+    component boxVerifiers[N];
+    // i and j iterate through the boxes
+    // k and m iterate through the entries in each box
+    for (var i = 0; i < sqrtN; i++) {
+        for (var j = 0; j < sqrtN; j++) {
+            var xTopLeftCorner = i*sqrtN;
+            var yTopLeftCorner = j*sqrtN;
+
+            // fill the verifier with the numbers in the box 
+            var boxIndex = i*sqrtN + j;
+            boxVerifiers[boxIndex] = SubgroupVerifier(N);
+            for (var k = 0; k < sqrtN; k++) {
+                for (var m = 0; m < sqrtN; m++) {
+                    var x = xTopLeftCorner + k;
+                    var y = yTopLeftCorner + m;
+                    var indexInBox = k*sqrtN + m;
+                    boxVerifiers[boxIndex].in[indexInBox] <== solved[x][y];
+                }
+            }
+
+            boxVerifiers[boxIndex].out === 1;
+        }
+    }
+
+    // verify that solved solves unsolved
+    // NOTE: idea stolen from https://github.com/vplasencia/zkSudoku/blob/main/circuits/sudoku/sudoku.circom
+    component isEquals[N][N];
+    component isZeros[N][N];
+    for (var i = 0; i < N; i++) {
+        for (var j = 0; j < N; j++) {
+            isEquals[i][j] = IsEqual();
+            isEquals[i][j].in[0] <== solved[i][j];
+            isEquals[i][j].in[1] <== unsolved[i][j];
+
+            isZeros[i][j] = IsZero();
+            isZeros[i][j].in <== unsolved[i][j];
+
+            isEquals[i][j].out === 1 - isZeros[i][j].out;
+        }
+    }
+}
+
+// K boards proven together, each board checked by its own Sudoku(sqrtN, N).
+// One proof covers all of them, its size does not depend on K
+template SudokuBatch(K, sqrtN, N) {
+    signal input unsolved[K][N][N];
+    signal input solved[K][N][N];
+
+    component boards[K];
+    for (var k = 0; k < K; k++) {
+        boards[k] = Sudoku(sqrtN, N);
+        for (var i = 0; i < N; i++) {
+            for (var j = 0; j < N; j++) {
+                boards[k].unsolved[i][j] <== unsolved[k][i][j];
+                boards[k].solved[i][j] <== solved[k][i][j];
+            }
+        }
+    }
+}
+
+// Bits of each cell of a packed board, enough for 0..N
+function packBits(N) {
+    return nbits(N);
+}
+
+// Cells in each packed field element, 252 bits keep the decomposition
+// below the field size unique
+function packCells(N) {
+    return 252 \ packBits(N);
+}
+
+// Sudoku with the unsolved board packed into (N*N) / packCells(N) field
+// elements, rounded up, so that it needs only a couple of public inputs.
+// Cell i of the board is at bit packBits(N)*(i % packCells(N)) of
+// packed[i \ packCells(N)]
+template PackedSudoku(sqrtN, N) {
+    var bits = packBits(N);
+    var cells = packCells(N);
+    var elements = (N*N + cells - 1) \ cells;
+    signal input packed[elements];
+    signal input solved[N][N];
+
+    component board = Sudoku(sqrtN, N);
+    for (var i = 0; i < N; i++) {
+        for (var j = 0; j < N; j++) {
+            board.solved[i][j] <== solved[i][j];
+        }
+    }
+
+    // the bits of each element are constrained, so every unpacked cell is
+    // below 2**bits and board checks it is 0 or the solved number
+    component unpack[elements];
+    for (var e = 0; e < elements; e++) {
+        var n = N*N - e*cells < cells ? N*N - e*cells : cells;
+        unpack[e] = Num2Bits(n*bits);
+        unpack[e].in <== packed[e];
+        for (var c = 0; c < n; c++) {
+            var cell = 0;
+            for (var b = 0; b < bits; b++) {
+                cell += unpack[e].out[c*bits + b] * 2**b;
+            }
+            var k = e*cells + c;
+            board.unsolved[k \ N][k % N] <== cell;
+        }
+    }
+}
+
+// Sudoku with Poseidon of the packed unsolved board as its only public
+// signal, the board itself stays private. The packing is the one of
+// PackedSudoku, so the commitment is Poseidon(packed). packCells(N) must
+// leave at most 16 elements, the most circomlib Poseidon takes
+template CommittedSudoku(sqrtN, N) {
+    var bits = packBits(N);
+    var cells = packCells(N);
+    var elements = (N*N + cells - 1) \ cells;
+    signal input unsolved[N][N];
+    signal input solved[N][N];
+    signal output commitment;
+
+    component board = Sudoku(sqrtN, N);
+
+    // board constrains every cell to 0 or its solved number, 1..N, so the
+    // cells are below 2**bits without range checks of their own and no
+    // other board packs to the same elements
+    var packed[elements];
+    for (var e = 0; e < elements; e++) {
+        packed[e] = 0;
+    }
+    for (var i = 0; i < N; i++) {
+        for (var j = 0; j < N; j++) {
+            board.unsolved[i][j] <== unsolved[i][j];
+            board.solved[i][j] <== solved[i][j];
+
+            var k = i*N + j;
+            packed[k \ cells] += unsolved[i][j] * 2**(bits*(k % cells));
+        }
+    }
+
+    component hash = Poseidon(elements);
+    for (var e = 0; e < elements; e++) {
+        hash.inputs[e] <== packed[e];
+    }
+    commitment <== hash.out;
+}
+
+// Permutation check of the subgroup verifiers, pick one per build:
+// 0 CountingPermutation, 1 OneHotPermutation, 2 DistinctPermutation
+// (see permutation.circom), the native witness engine of sudoku_cpp knows
+// only 2 and leaves the other two to the generic one
+function subgroupCheck() {
+    return 2;
+}
+
+// returns 1 iff the N input signals are numbers from 1 to N without any repetitions 
+// the inputs must already be range checked to 1..N, as Sudoku does with
+// SudokuNumberVerifier before any subgroup is verified
+template SubgroupVerifier(N) {
+    signal input in[N];
+    signal output out;
+
+    component check;
+    if (subgroupCheck() == 0) {
+        check = CountingPermutation(N);
+    } else if (subgroupCheck() == 1) {
+        check = OneHotPermutation(N);
+    } else {
+        check = DistinctPermutation(N);
+    }
+    for (var i = 0; i < N; i++) {
+        check.in[i] <== in[i];
+    }
+
+    out <== 1;
+}
+
+// constrains 1 <= in <= N, out is always 1
+// picks the range check with fewer constraints for N
+template NumberVerifier(N) {
+    signal input in;
+    signal output out;
+
+    component check;
+    if (N - 1 <= 2*(nbits(N - 1) + 1)) {
+        check = ProductRangeCheck(N);
+    } else {
+        check = BitsRangeCheck(N);
+    }
+    check.in <== in;
+    out <== 1;
+}
+
+// in is a root of (x - 1)(x - 2)...(x - N), N - 1 constraints
+template ProductRangeCheck(N) {
+    signal input in;
+
+    signal prod[N];
+    prod[0] <== in - 1;
+    for (var i = 1; i < N; i++) {
+        prod[i] <== prod[i-1] * (in - i - 1);
+    }
+    prod[N-1] === 0;
+}
+
+// in - 1 and N - in both fit in nbits(N - 1) bits, so 1 <= in <= N,
+// 2*(nbits(N - 1) + 1) constraints, each Num2Bits constrains its bits and
+// their sum
+template BitsRangeCheck(N) {
+    signal input in;
+
+    component low = Num2Bits(nbits(N - 1));
+    low.in <== in - 1;
+    component high = Num2Bits(nbits(N - 1));
+    high.in <== N - in;
+}
+
+// receives all numbers on a N by N sudoku board and verifies that each
+// value on the board satisfies 1 <= value <= N
+template SudokuNumberVerifier(N) {
+    signal input in[N*N];
+    signal output out;
+
+    component numberVerifiers[N*N];
+    for (var i = 0; i < N*N; i++) {
+           numberVerifiers[i] = NumberVerifier(N);
+           numberVerifiers[i].in <== in[i];
+           numberVerifiers[i].out === 1;
+    }
+
+    out <== 1;
+}
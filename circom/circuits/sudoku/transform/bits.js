@@ -0,0 +1,94 @@
+// Num2Bits through Fr_toBits of fr.hpp instead of one shift and mask per
+// bit. The line that reads the input is left marked with a leading \u0000
+// for the signal store pass, which turns it into a read into sigaux[0].
+
+// circomlib Num2Bits(n), n <= 64, whose loop sets out[i] to bit i of in and
+// adds it to lc1
+function toBitDecomposition(L, constants) {
+  const src = L.join("\n");
+  const lines = [
+    "{",
+    "PFrElement aux_dest = &lvar[1];",
+    "// load src",
+    "// end load src",
+    "Fr_copy(aux_dest,&circuitConstants[(\\d+)]);",
+    "}",
+    "{",
+    "PFrElement aux_dest = &lvar[2];",
+    "// load src",
+    "// end load src",
+    "Fr_copy(aux_dest,&circuitConstants[(\\d+)]);",
+    "}",
+    "{",
+    "PFrElement aux_dest = &lvar[3];",
+    "// load src",
+    "// end load src",
+    "Fr_copy(aux_dest,&circuitConstants[\\1]);",
+    "}",
+    "Fr_lt(&expaux[0],&lvar[3],&circuitConstants[(\\d+)]); // line circom (\\d+)",
+    "while(Fr_isTrue(&expaux[0])){",
+    "{",
+    "PFrElement aux_dest = &signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)];",
+    "// load src",
+    "Fr_shr(&expaux[1],&signalValues[mySignalStart + (\\d+)],&lvar[3]); // line circom (\\d+)",
+    "Fr_band(&expaux[0],&expaux[1],&circuitConstants[\\2]); // line circom \\6",
+    "// end load src",
+    "Fr_copy(aux_dest,&expaux[0]);",
+    "}",
+    "Fr_sub(&expaux[3],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&circuitConstants[\\2]); // line circom (\\d+)",
+    "Fr_mul(&expaux[1],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&expaux[3]); // line circom \\7",
+    "Fr_eq(&expaux[0],&expaux[1],&circuitConstants[\\1]); // line circom \\7",
+    "if (!Fr_isTrue(&expaux[0])) std::cout << \"Failed assert in template/function \" << myTemplateName << \" line \\7. \" <<  \"Followed trace of components: \" << ctx->getTrace(myId) << std::endl;",
+    "assert(Fr_isTrue(&expaux[0]));",
+    "{",
+    "PFrElement aux_dest = &lvar[1];",
+    "// load src",
+    "Fr_mul(&expaux[2],&signalValues[mySignalStart + ((1 * Fr_toInt(&lvar[3])) + 0)],&lvar[2]); // line circom (\\d+)",
+    "Fr_add(&expaux[0],&lvar[1],&expaux[2]); // line circom \\8",
+    "// end load src",
+    "Fr_copy(aux_dest,&expaux[0]);",
+    "}",
+    "{",
+    "PFrElement aux_dest = &lvar[2];",
+    "// load src",
+    "Fr_add(&expaux[0],&lvar[2],&lvar[2]); // line circom (\\d+)",
+    "// end load src",
+    "Fr_copy(aux_dest,&expaux[0]);",
+    "}",
+    "{",
+    "PFrElement aux_dest = &lvar[3];",
+    "// load src",
+    "Fr_add(&expaux[0],&lvar[3],&circuitConstants[\\2]); // line circom \\4",
+    "// end load src",
+    "Fr_copy(aux_dest,&expaux[0]);",
+    "}",
+    "Fr_lt(&expaux[0],&lvar[3],&circuitConstants[\\3]); // line circom \\4",
+    "}",
+  ];
+  const pattern = lines
+    .map((l) => l.replace(/[.*+?^${}()|[\]\\]/g, "\\$&").replace(/\\\(\\\\d\\\+\\\)/g, "(\\d+)").replace(/\\\\(\d)/g, "\\$1"))
+    .join("\n");
+  const m = src.match(new RegExp(pattern));
+  if (!m) return L;
+  const zero = constants[m[1]], one = constants[m[2]], n = constants[m[3]];
+  const input = parseInt(m[5]);
+  if (zero !== 0 || one !== 1 || n === null || n < 1 || n > 64 || input !== n) return L;
+  const replacement = [
+    "signalValues[mySignalStart + " + n + "]",
+    "{",
+    "FrElement bits[" + n + "];",
+    "Fr_toBits(&bits[0],&sigaux[0]," + n + "); // line circom " + m[6],
+    "signalValues->setn(mySignalStart + 0,&bits[0]," + n + ");",
+    "// lc1 accumulated natively, every out[i] is a short 0 or 1",
+    "u64 lc1 = 0;",
+    "for (uint i = 0; i < " + n + "; i++) {",
+    "lc1 |= ((u64)bits[i].shortVal) << i;",
+    "}",
+    "Fr_fromU64(&lvar[1],lc1);",
+    "}",
+  ];
+  // the first line is the read of in, left to the signal store pass
+  return (src.slice(0, m.index) + "\u0000" + replacement.join("\n") + src.slice(m.index + m[0].length)).split("\n");
+}
+
+module.exports = { toBitDecomposition };
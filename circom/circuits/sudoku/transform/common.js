@@ -0,0 +1,70 @@
+// Helpers shared by the passes of transform_cpp.js, which read the code of
+// "circom --c" line by line
+
+function fail(msg) {
+  throw new Error("transform_cpp: " + msg);
+}
+
+function getNumber(src, name) {
+  const m = src.match(new RegExp("uint " + name + "\\(\\) \\{return (\\d+);\\}"));
+  if (!m) fail("no " + name);
+  return parseInt(m[1]);
+}
+
+function constantOf(constants, operand) {
+  const m = operand.match(/^&circuitConstants\[(\d+)\]$/);
+  if (!m) return null;
+  return constants[parseInt(m[1])];
+}
+
+// {
+// PFrElement aux_dest = &<dest>;
+// // load src
+// <load>
+// // end load src
+// Fr_copy(aux_dest,<src>);
+// }
+function parseAssign(L, i) {
+  if (L[i] !== "{" || !L[i + 1] || !L[i + 1].startsWith("PFrElement aux_dest = &") || L[i + 2] !== "// load src") {
+    return null;
+  }
+  let k = i + 3;
+  while (k < L.length && L[k] !== "// end load src") {
+    if (L[k] === "{" || L[k] === "}") return null;
+    k++;
+  }
+  if (k + 2 >= L.length || !L[k + 1].startsWith("Fr_copy(aux_dest,") || L[k + 2] !== "}") return null;
+  return {
+    dest: L[i + 1].slice("PFrElement aux_dest = &".length, -1),
+    load: L.slice(i + 3, k),
+    src: L[k + 1].slice("Fr_copy(aux_dest,".length, -2),
+    end: k + 2,
+  };
+}
+
+function closingLine(L, i) {
+  let depth = 0;
+  for (let j = i; j < L.length; j++) {
+    for (const c of L[j]) {
+      if (c === "{") depth++;
+      else if (c === "}") depth--;
+    }
+    if (depth === 0) return j;
+  }
+  fail("unbalanced block at line " + i);
+}
+
+// The subcomponents a run function creates, by aux_create index
+function createdSubcomponents(body) {
+  const re = /uint aux_create = (\d+);\nint aux_cmp_num = [^\n]*\nuint csoffset = mySignalStart\+(\d+);\n(?:uint aux_dimensions[^\n]*\n)?for \(uint i = 0; i < (\d+); i\+\+\) \{\n(?:.*\n)*?\w+_(\d+)_create\(csoffset,[^\n]*\ncsoffset \+= (\d+) ;/g;
+  const subs = [];
+  let m;
+  while ((m = re.exec(body))) {
+    const [first, offset, count, templateId, size] = m.slice(1).map((x) => parseInt(x));
+    for (let i = 0; i < count; i++) subs[first + i] = { templateId, offset: offset + size * i, size };
+  }
+  for (let i = 0; i < subs.length; i++) if (!subs[i]) fail("subcomponent " + i + " is never created");
+  return subs;
+}
+
+module.exports = { fail, getNumber, constantOf, parseAssign, closingLine, createdSubcomponents };
@@ -0,0 +1,24 @@
+// Writes in place: locals that take a constant are copied without the
+// expaux block, and the names of a run are referenced instead of copied
+
+const { parseAssign } = require("./common");
+
+function toConstantCopies(L) {
+  const out = [];
+  for (let i = 0; i < L.length; i++) {
+    const a = parseAssign(L, i);
+    if (a && !a.load.length && a.dest.startsWith("lvar[") && a.src.startsWith("&circuitConstants[")) {
+      out.push("Fr_copy(&" + a.dest + "," + a.src + ");");
+      i = a.end;
+      continue;
+    }
+    out.push(L[i]);
+  }
+  return out;
+}
+
+function toNameReferences(L) {
+  return L.map((l) => l.replace(/^std::string (myTemplateName|myComponentName) = /, "const std::string &$1 = "));
+}
+
+module.exports = { toConstantCopies, toNameReferences };
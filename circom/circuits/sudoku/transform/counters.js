@@ -0,0 +1,146 @@
+// Loop counters of the generated code as native uints in uvar instead of
+// field elements in lvar
+
+const { constantOf, parseAssign, closingLine } = require("./common");
+
+// for (var i = 0; i < <constant>; i++) on lvar[k]
+function parseLoop(L, i, constants) {
+  const init = parseAssign(L, i);
+  if (!init || init.load.length || constantOf(constants, init.src) !== 0) return null;
+  const dm = init.dest.match(/^lvar\[(\d+)\]$/);
+  if (!dm) return null;
+  const k = dm[1];
+  const cond = L[init.end + 1] || "";
+  const cm = cond.match(new RegExp("^Fr_lt\\(&expaux\\[0\\],&lvar\\[" + k + "\\],(&circuitConstants\\[\\d+\\])\\); // line circom (\\d+)$"));
+  if (!cm || L[init.end + 2] !== "while(Fr_isTrue(&expaux[0])){") return null;
+  const bound = constantOf(constants, cm[1]);
+  if (bound === null || bound < 0) return null;
+  const close = closingLine(L, init.end + 2);
+  const inc = parseAssign(L, close - 8);
+  if (!inc || inc.end !== close - 2 || inc.dest !== "lvar[" + k + "]" || inc.load.length !== 1 ||
+      inc.src !== "&expaux[0]" || L[close - 1] !== cond) {
+    return null;
+  }
+  const im = inc.load[0].match(new RegExp("^Fr_add\\(&expaux\\[0\\],&lvar\\[" + k + "\\],(&circuitConstants\\[\\d+\\])\\); // line circom \\d+$"));
+  if (!im || constantOf(constants, im[1]) !== 1) return null;
+  return { slot: parseInt(k), start: i, body: init.end + 3, close, bound, line: cm[2] };
+}
+
+// lvar[d] = sums and products of locals and short constants
+function parseDerived(L, i, constants) {
+  const a = parseAssign(L, i);
+  if (!a || !a.load.length || a.src !== "&expaux[0]") return null;
+  const dm = a.dest.match(/^lvar\[(\d+)\]$/);
+  if (!dm) return null;
+  const exprs = {};
+  const slots = [];
+  let last = null;
+  let line = null;
+  for (const op of a.load) {
+    const m = op.match(/^Fr_(mul|add)\(&expaux\[(\d+)\],(&[^,]+),(&[^,]+)\); \/\/ line circom (\d+)$/);
+    if (!m) return null;
+    const args = [];
+    for (const operand of [m[3], m[4]]) {
+      let lm, em;
+      if ((lm = operand.match(/^&lvar\[(\d+)\]$/))) {
+        slots.push(parseInt(lm[1]));
+        args.push("uvar[" + lm[1] + "]");
+      } else if ((em = operand.match(/^&expaux\[(\d+)\]$/)) && exprs[em[1]] !== undefined) {
+        args.push("(" + exprs[em[1]] + ")");
+      } else {
+        const c = constantOf(constants, operand);
+        if (c === null || c < 0) return null;
+        args.push(String(c));
+      }
+    }
+    exprs[m[2]] = args[0] + (m[1] === "mul" ? " * " : " + ") + args[1];
+    last = m[2];
+    line = m[5];
+  }
+  if (last !== "0") return null;
+  return { slot: parseInt(dm[1]), start: i, end: a.end, slots, expr: exprs[0], line };
+}
+
+// Loop counters and the locals computed only from them become uvar, as
+// long as every other use of them is an index (Fr_toInt)
+function nativeCounters(L, constants) {
+  const loops = [];
+  const derived = [];
+  for (let i = 0; i < L.length; i++) {
+    if (L[i] !== "{") continue;
+    const loop = parseLoop(L, i, constants);
+    if (loop) loops.push(loop);
+  }
+  // the increments of the loops are not derived locals
+  const increments = new Set(loops.map((l) => l.close - 8));
+  for (let i = 0; i < L.length; i++) {
+    if (L[i] !== "{" || increments.has(i)) continue;
+    const d = parseDerived(L, i, constants);
+    if (d) derived.push(d);
+  }
+  const S = new Set(loops.map((l) => l.slot).concat(derived.map((d) => d.slot)));
+  let changed = true;
+  while (changed) {
+    changed = false;
+    const owner = new Array(L.length).fill(null);
+    for (const l of loops) {
+      if (!S.has(l.slot)) continue;
+      for (let j = l.start; j < l.body; j++) owner[j] = l.slot;
+      for (let j = l.close - 8; j < l.close; j++) owner[j] = l.slot;
+    }
+    for (const d of derived) {
+      if (!S.has(d.slot)) continue;
+      if (d.slots.some((x) => !S.has(x))) {
+        S.delete(d.slot);
+        changed = true;
+        continue;
+      }
+      for (let j = d.start; j <= d.end; j++) owner[j] = "derived";
+    }
+    if (changed) continue;
+    for (let j = 0; j < L.length; j++) {
+      const re = /&lvar\[(\d+)\]/g;
+      let m;
+      while ((m = re.exec(L[j]))) {
+        const x = parseInt(m[1]);
+        if (!S.has(x)) continue;
+        const isIndex = L[j].slice(m.index - "Fr_toInt(".length, m.index) === "Fr_toInt(" && L[j][re.lastIndex] === ")";
+        if (isIndex || owner[j] === x || owner[j] === "derived") continue;
+        S.delete(x);
+        changed = true;
+      }
+    }
+  }
+  return {
+    slots: S,
+    loops: loops.filter((l) => S.has(l.slot)),
+    derived: derived.filter((d) => S.has(d.slot)),
+  };
+}
+
+function toNativeCounters(L, constants) {
+  const { slots, loops, derived } = nativeCounters(L, constants);
+  if (!slots.size) return { L, native: false };
+  const replace = new Array(L.length).fill(undefined);
+  for (const l of loops) {
+    const k = l.slot;
+    replace[l.start] = ["for (uvar[" + k + "] = 0; uvar[" + k + "] < " + l.bound + "; uvar[" + k + "]++) { // line circom " + l.line];
+    for (let j = l.start + 1; j < l.body; j++) replace[j] = [];
+    for (let j = l.close - 8; j < l.close; j++) replace[j] = [];
+  }
+  for (const d of derived) {
+    replace[d.start] = ["uvar[" + d.slot + "] = " + d.expr + "; // line circom " + d.line];
+    for (let j = d.start + 1; j <= d.end; j++) replace[j] = [];
+  }
+  const out = [];
+  for (let j = 0; j < L.length; j++) {
+    if (replace[j] !== undefined) {
+      out.push(...replace[j]);
+      continue;
+    }
+    out.push(L[j].replace(/Fr_toInt\(&lvar\[(\d+)\]\)/g, (s, k) => (slots.has(parseInt(k)) ? "uvar[" + k + "]" : s)));
+  }
+  return { L: out, native: true };
+}
+
+module.exports = { toNativeCounters };
@@ -0,0 +1,37 @@
+// The signal layout tables of circom.hpp, from which the runtime places the
+// signals of every component and keeps the ones outside the witness in a
+// shared scratch area
+
+const { fail } = require("./common");
+
+function formatPairs(pairs) {
+  const rows = [];
+  for (let i = 0; i < pairs.length; i += 12) {
+    rows.push(pairs.slice(i, i + 12).map((p) => "{" + p[0] + "," + p[1] + "}").join(","));
+  }
+  return rows.join(",\n");
+}
+
+// subsOf[t] as createdSubcomponents gives them for the run of template t,
+// signalNo[t] the number of signals of t
+function layoutTables(mainId, signalNo, subsOf) {
+  const n = signalNo.length;
+  const subStart = [0];
+  const pairs = [];
+  for (let t = 0; t < n; t++) {
+    if (signalNo[t] === undefined) fail("template " + t + " is never created");
+    for (const s of subsOf[t] || []) pairs.push([s.templateId, s.offset]);
+    subStart.push(pairs.length);
+  }
+  return [
+    "uint get_main_template_id() {return " + mainId + ";}",
+    "",
+    "const uint _templateSignalNo[" + n + "] = {" + signalNo.join(",") + "};",
+    "",
+    "const uint _templateSubcomponentStart[" + (n + 1) + "] = {" + subStart.join(",") + "};",
+    "",
+    "const uint _templateSubcomponents[" + pairs.length + "][2] = {\n" + formatPairs(pairs) + "};",
+  ];
+}
+
+module.exports = { layoutTables };
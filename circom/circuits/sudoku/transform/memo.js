@@ -0,0 +1,56 @@
+// Subcomponents run through Circom_CalcWit::runComponent, which memoizes
+// the pure ones, and the input tables of circom.hpp it keys them by
+
+const { fail, createdSubcomponents } = require("./common");
+
+function toRunComponent(L) {
+  return L.map((l) =>
+    l.replace(/^\w+_run\(mySubcomponents\[cmp_index_ref\],ctx\);$/, "ctx->runComponent(mySubcomponents[cmp_index_ref]);")
+  );
+}
+
+// Inputs a parent writes of each template, from the lowest offset written
+function inputStarts(src, templates) {
+  const start = [];
+  const re = /^void (\w+)_run\(uint ctx_index,Circom_CalcWit\* ctx\)\{$/gm;
+  let m;
+  while ((m = re.exec(src))) {
+    const end = src.indexOf("\n}\n\n", m.index);
+    const body = src.slice(m.index, end);
+    const subs = createdSubcomponents(body);
+    let cur = null;
+    for (const l of body.split("\n")) {
+      const c = l.match(/^uint cmp_index_ref = (.*);$/);
+      if (c) cur = c[1];
+      const w = l.match(/^PFrElement aux_dest = &ctx->signalValues\[ctx->componentMemory\[mySubcomponents\[(.*)\]\]\.signalStart \+ (.*)\];$/);
+      if (!w) continue;
+      let ids;
+      const e = w[1] === "cmp_index_ref" ? cur : w[1];
+      if (/^\d+$/.test(e)) {
+        ids = [subs[parseInt(e)].templateId];
+      } else {
+        ids = subs.map((s) => s.templateId);
+      }
+      const o = w[2].match(/(\d+)\)*$/);
+      if (!o) fail("cannot read the input offset " + w[2]);
+      for (const t of ids) start[t] = Math.min(start[t] === undefined ? Infinity : start[t], parseInt(o[1]));
+    }
+  }
+  return start;
+}
+
+// _templateInputStart and _templateInputNo, starts as inputStarts gives
+// them with the one of main filled in
+function inputTables(templates, starts) {
+  const n = templates.length;
+  for (let t = 0; t < n; t++) {
+    if (starts[t] === undefined) fail("no input of template " + t + " is written");
+  }
+  return [
+    "const uint _templateInputStart[" + n + "] = {" + starts.join(",") + "};",
+    "",
+    "const uint _templateInputNo[" + n + "] = {" + templates.map((t) => t.inputs).join(",") + "};",
+  ];
+}
+
+module.exports = { toRunComponent, inputStarts, inputTables };
@@ -0,0 +1,30 @@
+// Subcomponent signals addressed from offsets known when the code is
+// generated instead of the signalStart of their componentMemory
+
+// subs as createdSubcomponents of common.js gives them
+function toConstantOffsets(name, L, subs) {
+  if (!subs.length) return L;
+  let cur = null;
+  let usesTable = false;
+  const out = L.map((l) => {
+    const m = l.match(/^uint cmp_index_ref = (.*);$/);
+    if (m) cur = m[1];
+    const l2 = l.replace(/ctx->componentMemory\[mySubcomponents\[((?:[^[\]]|\[[^[\]]*\])*)\]\]\.signalStart/g, (s, e) => {
+      if (e === "cmp_index_ref" && /^\d+$/.test(cur)) e = cur;
+      if (/^\d+$/.test(e)) return "mySignalStart + " + subs[parseInt(e)].offset;
+      usesTable = true;
+      return "mySignalStart + " + name + "_subcomponentOffsets[" + e + "]";
+    });
+    return l2 !== l ? l2.replace(/ctx->signalValues\./g, "signalValues->") : l;
+  });
+  if (usesTable) {
+    out.unshift(
+      "// Signal offsets of the subcomponents, relative to mySignalStart",
+      "static const uint " + name + "_subcomponentOffsets[" + subs.length + "] = {" + subs.map((s) => s.offset).join(",") + "};",
+      ""
+    );
+  }
+  return out;
+}
+
+module.exports = { toConstantOffsets };
@@ -0,0 +1,95 @@
+// Signals of the generated code through the Circom_SignalStore of
+// calcwit.hpp instead of a plain FrElement array
+
+const { fail } = require("./common");
+
+// The index of the first &signalValues[...] or &ctx->signalValues[...] of line
+function findSignal(line) {
+  const m = /&(ctx->)?signalValues\[/.exec(line);
+  if (!m) return null;
+  let i = m.index + m[0].length;
+  let depth = 1;
+  while (depth) {
+    if (line[i] === "[") depth++;
+    else if (line[i] === "]") depth--;
+    i++;
+  }
+  return {
+    start: m.index,
+    end: i,
+    store: m[1] ? "ctx->signalValues." : "signalValues->",
+    index: line.slice(m.index + m[0].length, i - 1),
+  };
+}
+
+// Reads of signals go to sigaux, writes to set and copy
+function toSignalStore(L) {
+  const out = [];
+  let dest = null;
+  for (let l of L) {
+    if (l === "FrElement* signalValues = ctx->signalValues;") {
+      out.push("Circom_SignalStore* signalValues = &ctx->signalValues;");
+      continue;
+    }
+    if (l.startsWith("\u0000")) {
+      // the input of the bit decomposition
+      const r = findSignal("&" + l.slice(1));
+      out.push(r.store + "get(" + r.index + ",&sigaux[0]);");
+      continue;
+    }
+    if (l.startsWith("PFrElement aux_dest = &") && /^PFrElement aux_dest = &(ctx->)?signalValues\[/.test(l)) {
+      const r = findSignal(l);
+      dest = r;
+      continue;
+    }
+    if (l.startsWith("Fr_copy(aux_dest,") && dest) {
+      const src = l.slice("Fr_copy(aux_dest,".length, -2);
+      const r = findSignal(src);
+      if (r && r.start === 0 && r.end === src.length) {
+        out.push(dest.store + "copy(" + dest.index + "," + r.index + ");");
+        dest = null;
+        continue;
+      }
+      l = dest.store + "set(" + dest.index + "," + src + ");";
+      dest = null;
+    }
+    const n = l.match(/^Fr_copyn\(aux_dest,(.*),(\d+)\);$/);
+    if (n) {
+      // array assignments
+      const r = findSignal(n[1]);
+      const whole = r && r.start === 0 && r.end === n[1].length;
+      if (r && !whole) fail("cannot copy " + l);
+      if (dest && r) {
+        l = "for (uint aux_i = 0; aux_i < " + n[2] + "; aux_i++) " + dest.store + "copy(" + dest.index + " + aux_i," + r.index + " + aux_i);";
+      } else if (dest) {
+        l = dest.store + "setn(" + dest.index + "," + n[1] + "," + n[2] + ");";
+      } else if (r) {
+        l = "for (uint aux_i = 0; aux_i < " + n[2] + "; aux_i++) " + r.store + "get(" + r.index + " + aux_i,&aux_dest[aux_i]);";
+      }
+      dest = null;
+      out.push(l);
+      continue;
+    }
+    const pre = [];
+    let r;
+    while ((r = findSignal(l))) {
+      pre.push(r.store + "get(" + r.index + ",&sigaux[" + pre.length + "]);");
+      l = l.slice(0, r.start) + "&sigaux[" + (pre.length - 1) + "]" + l.slice(r.end);
+    }
+    out.push(...pre, l);
+  }
+  return out;
+}
+
+// Number of sigaux temporaries the reads of L need
+function sigauxSize(L) {
+  let n = 0;
+  for (const l of L) {
+    const re = /&sigaux\[(\d+)\]/g;
+    let m;
+    while ((m = re.exec(l))) n = Math.max(n, parseInt(m[1]) + 1);
+  }
+  return n;
+}
+
+module.exports = { toSignalStore, sigauxSize };
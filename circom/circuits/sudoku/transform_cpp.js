@@ -0,0 +1,138 @@
+// Rewrites the <circuit>.cpp of "circom --c" into the form the runtime of
+// sudoku_cpp expects, compile.sh runs it after every build. Each rewrite is
+// a pass in transform/:
+//
+//   - signals.js: the signals go through the Circom_SignalStore of
+//     calcwit.hpp,
+//   - memo.js: subcomponents run through Circom_CalcWit::runComponent,
+//     which memoizes them, and the input tables it keys them by,
+//   - offsets.js: subcomponent signals are addressed from constant offsets,
+//   - layout.js: the signal layout tables of circom.hpp,
+//   - counters.js: loop counters and the indexes computed from them are
+//     native uints,
+//   - copies.js: the locals that take a constant are copied without a
+//     temporary,
+//   - bits.js: Num2Bits of up to 64 bits decomposes its input with
+//     Fr_toBits.
+//
+// The runtime needs the first four. The last three only speed the code up,
+// and a run function whose code they do not expect is left as circom wrote
+// it, with a warning. The constants of the loop bounds are read from the
+// .dat.
+//
+//   node transform_cpp.js <circom .cpp> <circom .dat> <output .cpp>
+
+const fs = require("fs");
+const { fail, getNumber, createdSubcomponents } = require("./transform/common");
+const { toBitDecomposition } = require("./transform/bits");
+const { toSignalStore, sigauxSize } = require("./transform/signals");
+const { toNativeCounters } = require("./transform/counters");
+const { toConstantCopies, toNameReferences } = require("./transform/copies");
+const { toConstantOffsets } = require("./transform/offsets");
+const { toRunComponent, inputStarts, inputTables } = require("./transform/memo");
+const { layoutTables } = require("./transform/layout");
+
+// The short values of the circuit constants, null for the long ones
+function readConstants(datFile, src) {
+  const dat = fs.readFileSync(datFile);
+  const n = getNumber(src, "get_size_of_constants");
+  let offset = getNumber(src, "get_size_of_input_hashmap") * 24 + getNumber(src, "get_size_of_witness") * 8;
+  const constants = [];
+  for (let i = 0; i < n; i++) {
+    const type = dat.readUInt32LE(offset + 4);
+    constants.push(type & 0x80000000 ? null : dat.readInt32LE(offset));
+    offset += 40;
+  }
+  return constants;
+}
+
+// pass(L) of an optional pass, or fallback (L itself by default) when the
+// pass does not know the code of name_run
+function optional(name, pass, passName, L, fallback = L) {
+  try {
+    return pass(L);
+  } catch (err) {
+    console.error("transform_cpp: " + passName + " skipped in " + name + "_run, " + err.message);
+    return fallback;
+  }
+}
+
+function transformRun(name, body, constants) {
+  const subs = createdSubcomponents(body);
+  let L = body.split("\n");
+  L = optional(name, (L) => toBitDecomposition(L, constants), "toBitDecomposition", L);
+  const counters = optional(name, (L) => toNativeCounters(L, constants), "toNativeCounters", L, {
+    L,
+    native: false,
+  });
+  L = counters.L;
+  L = optional(name, toConstantCopies, "toConstantCopies", L);
+  L = toSignalStore(L);
+  L = toConstantOffsets(name, L, subs);
+  L = toRunComponent(L);
+  L = toNameReferences(L);
+  const i = L.findIndex((l) => /^FrElement lvar\[\d+\];$/.test(l));
+  if (i < 0) fail("no lvar in " + name + "_run");
+  const decls = [];
+  if (counters.native) decls.push("uint uvar[" + L[i].match(/\d+/)[0] + "];");
+  decls.push("FrElement sigaux[" + sigauxSize(L) + "];");
+  L.splice(i + 1, 0, ...decls);
+  return { body: L.join("\n"), subs };
+}
+
+function transform(src, constants) {
+  const templates = [];
+  const createRe = /^void (\w+)_(\d+)_create\(uint soffset[^\n]*\)\{\n((?:.*\n)*?)\}$/gm;
+  let m;
+  while ((m = createRe.exec(src))) {
+    const id = parseInt(m[2]);
+    templates[id] = {
+      name: m[1],
+      inputs: parseInt(m[3].match(/\.inputCounter = (\d+);/)[1]),
+    };
+  }
+  for (let t = 0; t < templates.length; t++) if (!templates[t]) fail("no template " + t);
+  const main = src.match(/^void run\(Circom_CalcWit\* ctx\)\{\n\w+_(\d+)_create\(1,0,ctx,"main",0\);$/m);
+  if (!main) fail("no main component");
+  const mainId = parseInt(main[1]);
+  const starts = inputStarts(src, templates);
+  starts[mainId] = getNumber(src, "get_main_input_signal_start") - 1;
+
+  const signalNo = [];
+  signalNo[mainId] = getNumber(src, "get_total_signal_no") - 1;
+  const subsOf = [];
+  const out = src.replace(/^void (\w+)_(\d+)_run\(uint ctx_index,Circom_CalcWit\* ctx\)\{\n(?:.*\n)*?\}\n(?=\n)/gm, (body, name, id) => {
+    const r = transformRun(name + "_" + id, body.slice(0, -1), constants);
+    subsOf[parseInt(id)] = r.subs;
+    for (const s of r.subs) signalNo[s.templateId] = s.size;
+    return r.body + "\n";
+  });
+
+  const n = templates.length;
+  signalNo.length = n;
+  const tables = [
+    ...layoutTables(mainId, signalNo, subsOf),
+    "",
+    ...inputTables(templates, starts),
+    "",
+    "const char *_templateNames[" + n + "] = {" + templates.map((t) => JSON.stringify(t.name)).join(",") + "};",
+    "",
+    "",
+  ].join("\n");
+  const anchor = /^uint get_size_of_io_map\(\) \{return \d+;\}\n\n/m;
+  const a = out.match(anchor);
+  if (!a) fail("no get_size_of_io_map");
+  return out.slice(0, a.index + a[0].length) + tables + out.slice(a.index + a[0].length);
+}
+
+if (require.main === module) {
+  if (process.argv.length !== 5) {
+    console.error("Usage: node transform_cpp.js <circom .cpp> <circom .dat> <output .cpp>");
+    process.exit(1);
+  }
+  const src = fs.readFileSync(process.argv[2], "utf8");
+  const constants = readConstants(process.argv[3], src);
+  fs.writeFileSync(process.argv[4], transform(src, constants));
+}
+
+module.exports = { transform, readConstants };
@@ -1,6 +1,102 @@
 const { assert } = require("chai");
+const { execSync } = require("child_process");
+const fs = require("fs");
+const os = require("os");
+const path = require("path");
 const wasm_tester = require("circom_tester").wasm;
 
+// The puzzle and its solution the batch, packed and committed tests start from
+const unsolved = [
+  [0, 0, 0, 0, 0, 6, 0, 0, 0],
+  [0, 0, 7, 2, 0, 0, 8, 0, 0],
+  [9, 0, 6, 8, 0, 0, 0, 1, 0],
+  [3, 0, 0, 7, 0, 0, 0, 2, 9],
+  [0, 0, 0, 0, 0, 0, 0, 0, 0],
+  [4, 0, 0, 5, 0, 0, 0, 7, 0],
+  [6, 5, 0, 1, 0, 0, 0, 0, 0],
+  [8, 0, 1, 0, 5, 0, 3, 0, 0],
+  [7, 9, 2, 0, 0, 0, 0, 0, 4],
+];
+const solved = [
+  [1, 8, 4, 3, 7, 6, 2, 9, 5],
+  [5, 3, 7, 2, 9, 1, 8, 4, 6],
+  [9, 2, 6, 8, 4, 5, 7, 1, 3],
+  [3, 6, 5, 7, 1, 8, 4, 2, 9],
+  [2, 7, 8, 4, 6, 9, 5, 3, 1],
+  [4, 1, 9, 5, 3, 2, 6, 7, 8],
+  [6, 5, 3, 1, 2, 4, 9, 8, 7],
+  [8, 4, 1, 9, 5, 7, 3, 6, 2],
+  [7, 9, 2, 6, 8, 3, 1, 5, 4],
+];
+
+// A 9x9 board packed as PackedSudoku and CommittedSudoku pack it, 4 bits per
+// cell, 63 cells per element, first cell in the lowest bits
+function pack(board) {
+  const cells = board.flat();
+  const packed = [];
+  for (let e = 0; e < cells.length; e += 63) {
+    let v = 0n;
+    cells.slice(e, e + 63).forEach((n, c) => (v += BigInt(n) << BigInt(4 * c)));
+    packed.push(v);
+  }
+  return packed;
+}
+
+const sudokuDir = path.join(__dirname, "..", "sudoku");
+
+// The values of a .wtns file, little endian elements of n8 bytes
+function readWtns(file) {
+  const b = fs.readFileSync(file);
+  let n8;
+  let values;
+  for (let pos = 12; pos < b.length; ) {
+    const type = b.readUInt32LE(pos);
+    const size = Number(b.readBigUInt64LE(pos + 4));
+    pos += 12;
+    if (type === 1) n8 = b.readUInt32LE(pos);
+    if (type === 2) {
+      values = [];
+      for (let i = 0; i < size; i += n8) {
+        let v = 0n;
+        for (let k = n8 - 1; k >= 0; k--) v = (v << 8n) + BigInt(b[pos + i + k]);
+        values.push(v);
+      }
+    }
+    pos += size;
+  }
+  return values;
+}
+
+// Builds the C++ witness generator of sudoku/<circuit>.circom as compile.sh
+// and the Makefile of sudoku_cpp do, skips the tests of the hook without
+// circom or nasm
+function buildGenerator(hook, circuit) {
+  hook.timeout(30 * 60 * 1000);
+  try {
+    execSync("command -v circom && command -v nasm", { stdio: "ignore" });
+  } catch (err) {
+    hook.skip();
+  }
+  execSync(`./compile.sh ${circuit}`, { cwd: sudokuDir, stdio: "ignore" });
+  execSync(`make CIRCUIT=${circuit}`, { cwd: path.join(sudokuDir, "sudoku_cpp"), stdio: "ignore" });
+}
+
+// Runs the generator of circuit on input with the given options, throws
+// when it fails, and returns the witness it writes
+function generatorWitness(circuit, input, options) {
+  const tmp = fs.mkdtempSync(path.join(os.tmpdir(), `${circuit}-`));
+  const json = path.join(tmp, "input.json");
+  const wtns = path.join(tmp, "witness.wtns");
+  fs.writeFileSync(json, JSON.stringify(input, (k, v) => (typeof v === "bigint" ? v.toString() : v)));
+  execSync(`./${circuit} ${json} ${wtns} ${options}`, { cwd: path.join(sudokuDir, "sudoku_cpp") });
+  return readWtns(wtns);
+}
+
+function assertSameWitness(actual, expected) {
+  assert.equal(actual.length, expected.length);
+  for (let i = 0; i < expected.length; i++) assert.equal(actual[i], expected[i], `signal ${i}`);
+}
+
 describe("Sudoku circuit", function () {
   let sudokuCircuit;
 
@@ -202,3 +298,322 @@ describe("Sudoku circuit", function () {
     }
   });
 });
+
+describe("Permutation checks", function () {
+  const permutation = [3, 9, 1, 4, 7, 2, 8, 5, 6];
+
+  // Replaces the value of a signal in a computed witness, as a cheating
+  // prover could
+  async function tamper(circuit, witness, signal, value) {
+    await circuit.loadSymbols();
+    const tampered = witness.slice();
+    tampered[circuit.symbols[signal].varIdx] = BigInt(value);
+    return tampered;
+  }
+
+  async function assertWitnessFails(circuit, input) {
+    let failed = false;
+    try {
+      await circuit.calculateWitness(input);
+    } catch (err) {
+      failed = true;
+      assert(err.message.includes("Assert Failed"));
+    }
+    assert(failed, "the witness should not be computed");
+  }
+
+  async function assertConstraintsFail(circuit, witness) {
+    let failed = false;
+    try {
+      await circuit.checkConstraints(witness);
+    } catch (err) {
+      failed = true;
+    }
+    assert(failed, "the witness should not satisfy the constraints");
+  }
+
+  for (const name of ["counting", "onehot", "distinct"]) {
+    describe(name, function () {
+      let circuit;
+
+      before(async function () {
+        circuit = await wasm_tester(`test/circuits/${name}_permutation.circom`);
+      });
+
+      it("Should accept a permutation", async function () {
+        const witness = await circuit.calculateWitness({ in: permutation });
+        await circuit.checkConstraints(witness);
+      });
+
+      it("Should fail due to a repeated number", async function () {
+        await assertWitnessFails(circuit, { in: [3, 9, 1, 4, 7, 2, 8, 5, 3] });
+      });
+    });
+  }
+
+  it("Should fail due to a number out of bounds in onehot", async function () {
+    // OneHotPermutation range checks its inputs, the other checks rely on
+    // SudokuNumberVerifier
+    const circuit = await wasm_tester("test/circuits/onehot_permutation.circom");
+    await assertWitnessFails(circuit, { in: [3, 9, 1, 4, 7, 2, 8, 5, 10] });
+    await assertWitnessFails(circuit, { in: [3, 9, 1, 4, 7, 2, 8, 5, 0] });
+  });
+
+  // CountingPermutation only holds for an honest prover, so only the other
+  // checks are tested against tampered witnesses
+  for (const name of ["onehot", "distinct"]) {
+    describe(`${name} soundness`, function () {
+      let circuit;
+      let witness;
+
+      before(async function () {
+        circuit = await wasm_tester(`test/circuits/${name}_permutation.circom`);
+        witness = await circuit.calculateWitness({ in: permutation });
+      });
+
+      it("Should reject a witness with a repeated input", async function () {
+        for (let i = 1; i < permutation.length; i++) {
+          const tampered = await tamper(circuit, witness, `main.in[${i}]`, permutation[0]);
+          await assertConstraintsFail(circuit, tampered);
+        }
+      });
+    });
+  }
+
+  // The hints are computed with <--, only the constraints stop a prover
+  // from choosing other values
+  describe("onehot hints", function () {
+    let circuit;
+    let witness;
+
+    before(async function () {
+      circuit = await wasm_tester("test/circuits/onehot_permutation.circom");
+      witness = await circuit.calculateWitness({ in: permutation });
+    });
+
+    it("Should reject a hot entry that is not a bit", async function () {
+      for (let i = 0; i < permutation.length; i++) {
+        const k = permutation[i] - 1;
+        await assertConstraintsFail(circuit, await tamper(circuit, witness, `main.hot[${i}][${k}]`, 2));
+      }
+    });
+
+    it("Should reject a hot row that points at another number", async function () {
+      for (let i = 0; i < permutation.length; i++) {
+        const k = permutation[i] - 1;
+        const other = (k + 1) % permutation.length;
+        let tampered = await tamper(circuit, witness, `main.hot[${i}][${k}]`, 0);
+        tampered = await tamper(circuit, tampered, `main.hot[${i}][${other}]`, 1);
+        await assertConstraintsFail(circuit, tampered);
+      }
+    });
+
+    it("Should reject a hot row without a 1", async function () {
+      const k = permutation[0] - 1;
+      await assertConstraintsFail(circuit, await tamper(circuit, witness, `main.hot[0][${k}]`, 0));
+    });
+  });
+
+  describe("distinct hints", function () {
+    const pairs = (permutation.length * (permutation.length - 1)) / 2;
+    let circuit;
+    let witness;
+
+    before(async function () {
+      circuit = await wasm_tester("test/circuits/distinct_permutation.circom");
+      witness = await circuit.calculateWitness({ in: permutation });
+      await circuit.loadSymbols();
+    });
+
+    it("Should reject an inverse hint of 0", async function () {
+      for (let p = 0; p < pairs; p++) {
+        await assertConstraintsFail(circuit, await tamper(circuit, witness, `main.inv[${p}]`, 0));
+      }
+    });
+
+    it("Should reject a wrong inverse hint", async function () {
+      for (let p = 0; p < pairs; p++) {
+        const inv = witness[circuit.symbols[`main.inv[${p}]`].varIdx];
+        await assertConstraintsFail(circuit, await tamper(circuit, witness, `main.inv[${p}]`, inv + 1n));
+      }
+    });
+  });
+});
+
+describe("Sudoku batch", function () {
+  // the same puzzle with the numbers relabeled, n -> 10 - n
+  const relabel = (board) => board.map((row) => row.map((n) => (n ? 10 - n : 0)));
+
+  let circuit;
+
+  before(async function () {
+    circuit = await wasm_tester("test/circuits/sudoku_batch.circom");
+  });
+
+  it("Should accept two solved boards", async function () {
+    const witness = await circuit.calculateWitness({
+      unsolved: [unsolved, relabel(unsolved)],
+      solved: [solved, relabel(solved)],
+    });
+    await circuit.checkConstraints(witness);
+  });
+
+  it("Should fail when one board is not solved", async function () {
+    let failed = false;
+    try {
+      // the second solution does not match its puzzle
+      await circuit.calculateWitness({
+        unsolved: [unsolved, unsolved],
+        solved: [solved, relabel(solved)],
+      });
+    } catch (err) {
+      failed = true;
+      assert(err.message.includes("Assert Failed"));
+    }
+    assert(failed, "the witness should not be computed");
+  });
+
+  // SudokuBatch(4, 3, 9) of sudoku/sudoku_batch.circom, which the native
+  // engine fills board by board
+  describe("witness generator", function () {
+    const input = {
+      unsolved: [unsolved, relabel(unsolved), unsolved, relabel(unsolved)],
+      solved: [solved, relabel(solved), solved, relabel(solved)],
+    };
+    let witness;
+
+    before(async function () {
+      buildGenerator(this, "sudoku_batch");
+      const batch = await wasm_tester(path.join(sudokuDir, "sudoku_batch.circom"));
+      witness = await batch.calculateWitness(input);
+    });
+
+    for (const engine of ["generic", "native"]) {
+      it(`Should give the wasm witness with the ${engine} engine`, function () {
+        this.timeout(5 * 60 * 1000);
+        assertSameWitness(generatorWitness("sudoku_batch", input, `--engine ${engine}`), witness);
+      });
+    }
+
+    it("Should match the generic engine on random batches", function () {
+      this.timeout(5 * 60 * 1000);
+      generatorWitness("sudoku_batch", input, "--verify-native 16");
+    });
+  });
+});
+
+describe("Packed Sudoku", function () {
+  let circuit;
+
+  before(async function () {
+    circuit = await wasm_tester("test/circuits/packed_sudoku.circom");
+  });
+
+  it("Should take the puzzle in two public inputs", async function () {
+    const packed = pack(unsolved);
+    assert.equal(packed.length, 2);
+    const witness = await circuit.calculateWitness({ packed, solved });
+    await circuit.checkConstraints(witness);
+  });
+
+  it("Should fail when a packed cell differs from the solution", async function () {
+    // the first cell becomes a 2 where the solution has a 1
+    const packed = pack(unsolved);
+    packed[0] += 2n;
+    let failed = false;
+    try {
+      await circuit.calculateWitness({ packed, solved });
+    } catch (err) {
+      failed = true;
+      assert(err.message.includes("Assert Failed"));
+    }
+    assert(failed, "the witness should not be computed");
+  });
+});
+
+describe("Committed Sudoku", function () {
+  let circuit;
+
+  before(async function () {
+    circuit = await wasm_tester("test/circuits/committed_sudoku.circom");
+  });
+
+  it("Should output the circomlibjs Poseidon of the packed board", async function () {
+    // 1 in the first cell and 2 in cell 63 pack to [1, 2], and
+    // 7853200120776062878684798364095072458815029376092732009249414926327459813530
+    // is poseidon([1, 2]) of the circomlibjs tests
+    const board = unsolved.map((row) => row.map(() => 0));
+    board[0][0] = 1;
+    board[7][0] = 2;
+    assert.deepEqual(pack(board), [1n, 2n]);
+    // the solution with 2 and 8 swapped, so that cell 63 is a 2
+    const swapped = solved.map((row) => row.map((n) => (n === 2 ? 8 : n === 8 ? 2 : n)));
+    const witness = await circuit.calculateWitness({ unsolved: board, solved: swapped });
+    await circuit.checkConstraints(witness);
+    await circuit.assertOut(witness, {
+      commitment: 7853200120776062878684798364095072458815029376092732009249414926327459813530n,
+    });
+  });
+
+  it("Should output the commitment of the native sudoku_commitment", async function () {
+    // computed by sudoku_commitment, whose Poseidon gives the vector above
+    const witness = await circuit.calculateWitness({ unsolved, solved });
+    await circuit.checkConstraints(witness);
+    await circuit.assertOut(witness, {
+      commitment: 8482440434781234936742750123135723725231744977179173140041491078084952688940n,
+    });
+  });
+
+  it("Should fail for another board with the same packed elements", async function () {
+    // 16 in cell 4 carries into cell 5, which drops from 6 to 5. The sum
+    // packs as the puzzle, Sudoku rejects both cells
+    const board = unsolved.map((row) => row.slice());
+    board[0][4] = 16;
+    board[0][5] = 5;
+    assert.deepEqual(pack(board), pack(unsolved));
+    let failed = false;
+    try {
+      await circuit.calculateWitness({ unsolved: board, solved });
+    } catch (err) {
+      failed = true;
+      assert(err.message.includes("Assert Failed"));
+    }
+    assert(failed, "the witness should not be computed");
+  });
+});
+
+// The C++ generators that compile.sh and transform_cpp.js make of the
+// circuits against the wasm ones circom makes, SudokuBatch is covered above
+describe("Generated C++ witness generators", function () {
+  const circuits = {
+    sudoku: { unsolved, solved },
+    sudoku_packed: { packed: pack(unsolved), solved },
+    sudoku_committed: { unsolved, solved },
+  };
+
+  for (const [circuit, input] of Object.entries(circuits)) {
+    describe(circuit, function () {
+      let witness;
+
+      before(async function () {
+        buildGenerator(this, circuit);
+        const wasm = await wasm_tester(path.join(sudokuDir, `${circuit}.circom`));
+        witness = await wasm.calculateWitness(input);
+      });
+
+      it("Should give the wasm witness", function () {
+        this.timeout(5 * 60 * 1000);
+        assertSameWitness(generatorWitness(circuit, input, "--engine generic"), witness);
+      });
+
+      if (circuit === "sudoku") {
+        it("Should match the generic engine with the native one", function () {
+          this.timeout(5 * 60 * 1000);
+          // --verify-native fails when the engine does not take the circuit
+          // or a witness differs from the generic one
+          generatorWitness(circuit, input, "--verify-native 16");
+        });
+      }
+    });
+  }
+});
@@ -0,0 +1,4 @@
+pragma circom 2.0.0;
+include "../../sudoku/permutation.circom";
+
+component main = DistinctPermutation(9);